@@ -460,6 +460,7 @@ void DrawNode::drawPoint(const Vec2& position, const float pointSize, const Colo
     
     _bufferCountGLPoint += 1;
     _dirtyGLPoint = true;
+    markSubtreeDirty();
 }
 
 void DrawNode::drawPoints(const Vec2 *position, unsigned int numberOfPoints, const Color4F &color)
@@ -481,6 +482,7 @@ void DrawNode::drawPoints(const Vec2 *position, unsigned int numberOfPoints, con
     
     _bufferCountGLPoint += numberOfPoints;
     _dirtyGLPoint = true;
+    markSubtreeDirty();
 }
 
 void DrawNode::drawLine(const Vec2 &origin, const Vec2 &destination, const Color4F &color)
@@ -497,6 +499,7 @@ void DrawNode::drawLine(const Vec2 &origin, const Vec2 &destination, const Color
     
     _bufferCountGLLine += 2;
     _dirtyGLLine = true;
+    markSubtreeDirty();
 }
 
 void DrawNode::drawRect(const Vec2 &origin, const Vec2 &destination, const Color4F &color)
@@ -682,6 +685,7 @@ void DrawNode::drawDot(const Vec2 &pos, float radius, const Color4F &color)
     _bufferCount += vertex_count;
     
     _dirty = true;
+    markSubtreeDirty();
 }
 
 void DrawNode::drawRect(const Vec2 &p1, const Vec2 &p2, const Vec2 &p3, const Vec2& p4, const Color4F &color)
@@ -763,6 +767,7 @@ void DrawNode::drawSegment(const Vec2 &from, const Vec2 &to, float radius, const
     _bufferCount += vertex_count;
     
     _dirty = true;
+    markSubtreeDirty();
 }
 
 void DrawNode::drawPolygon(const Vec2 *verts, int count, const Color4F &fillColor, float borderWidth, const Color4F &borderColor)
@@ -846,6 +851,7 @@ void DrawNode::drawPolygon(const Vec2 *verts, int count, const Color4F &fillColo
     _bufferCount += vertex_count;
     
     _dirty = true;
+    markSubtreeDirty();
 }
 
 void DrawNode::drawSolidRect(const Vec2 &origin, const Vec2 &destination, const Color4F &color)
@@ -909,6 +915,7 @@ void DrawNode::drawTriangle(const Vec2 &p1, const Vec2 &p2, const Vec2 &p3, cons
 
     _bufferCount += vertex_count;
     _dirty = true;
+    markSubtreeDirty();
 }
 
 void DrawNode::drawQuadraticBezier(const Vec2& from, const Vec2& control, const Vec2& to, unsigned int segments, const Color4F &color)
@@ -924,6 +931,7 @@ void DrawNode::clear()
     _dirtyGLLine = true;
     _bufferCountGLPoint = 0;
     _dirtyGLPoint = true;
+    markSubtreeDirty();
     _lineWidth = _defaultLineWidth;
 }
 
@@ -610,6 +610,7 @@ void Label::setFontAtlas(FontAtlas* atlas,bool distanceFieldEnabled /* = false *
     {
         _lineHeight = _fontAtlas->getLineHeight();
         _contentDirty = true;
+        markSubtreeDirty();
         _systemFontDirty = false;
     }
     _useDistanceField = distanceFieldEnabled;
@@ -665,6 +666,7 @@ void Label::setString(const std::string& text)
     {
         _utf8Text = text;
         _contentDirty = true;
+        markSubtreeDirty();
 
         std::u32string utf32String;
         if (StringUtils::UTF8ToUTF32(_utf8Text, utf32String))
@@ -682,6 +684,7 @@ void Label::setAlignment(TextHAlignment hAlignment,TextVAlignment vAlignment)
         _vAlignment = vAlignment;
 
         _contentDirty = true;
+        markSubtreeDirty();
     }
 }
 
@@ -691,6 +694,7 @@ void Label::setMaxLineWidth(float maxLineWidth)
     {
         _maxLineWidth = maxLineWidth;
         _contentDirty = true;
+        markSubtreeDirty();
     }
 }
 
@@ -708,6 +712,7 @@ void Label::setDimensions(float width, float height)
 
         _maxLineWidth = width;
         _contentDirty = true;
+        markSubtreeDirty();
 
         if(_overflow == Overflow::SHRINK){
             if (_originalFontSize > 0) {
@@ -735,7 +740,8 @@ void Label::setLineBreakWithoutSpace(bool breakWithoutSpace)
     if (breakWithoutSpace != _lineBreakWithoutSpaces)
     {
         _lineBreakWithoutSpaces = breakWithoutSpace;
-        _contentDirty = true;     
+        _contentDirty = true;
+        markSubtreeDirty();
     }
 }
 
@@ -1015,6 +1021,7 @@ void Label::setBMFontSizeInternal(float fontSize)
     if(_currentLabelType == LabelType::BMFONT){
         this->setBMFontFilePath(_bmFontPath, Vec2::ZERO, fontSize);
         _contentDirty = true;
+        markSubtreeDirty();
     }
 }
 
@@ -1051,6 +1058,7 @@ void Label::enableGlow(const Color4B& glowColor)
             config.distanceFieldEnabled = true;
             setTTFConfig(config);
             _contentDirty = true;
+            markSubtreeDirty();
         }
         _currLabelEffect = LabelEffect::GLOW;
         _effectColorF.r = glowColor.r / 255.0f;
@@ -1088,6 +1096,7 @@ void Label::enableOutline(const Color4B& outlineColor,int outlineSize /* = -1 */
             _effectColorF.a = outlineColor.a / 255.f;
             _currLabelEffect = LabelEffect::OUTLINE;
             _contentDirty = true;
+            markSubtreeDirty();
         }
         _outlineSize = outlineSize;
     }
@@ -1167,6 +1176,7 @@ void Label::enableUnderline()
         _underlineNode = DrawNode::create();
         addChild(_underlineNode, 100000);
         _contentDirty = true;
+        markSubtreeDirty();
     }
 }
 
@@ -1200,6 +1210,7 @@ void Label::disableEffect(LabelEffect effect)
                 }
                 _currLabelEffect = LabelEffect::NORMAL;
                 _contentDirty = true;
+                markSubtreeDirty();
             }
             break;
         case cocos2d::LabelEffect::SHADOW:
@@ -1805,6 +1816,7 @@ void Label::setLineHeight(float height)
     {
         _lineHeight = height;
         _contentDirty = true;
+        markSubtreeDirty();
     }
 }
 
@@ -1820,6 +1832,7 @@ void Label::setLineSpacing(float height)
     {
         _lineSpacing = height;
         _contentDirty = true;
+        markSubtreeDirty();
     }
 }
 
@@ -1837,6 +1850,7 @@ void Label::setAdditionalKerning(float space)
         {
             _additionalKerning = space;
             _contentDirty = true;
+            markSubtreeDirty();
         }
     }
     else
@@ -1926,6 +1940,7 @@ void Label::updateDisplayedColor(const Color3B& parentColor)
         // Correct solution is to update the DrawNode directly since we know it is
         // a line. Returning a pointer to the line is an option
         _contentDirty = true;
+        markSubtreeDirty();
     }
 
     for (auto&& it : _letters)
@@ -1963,6 +1978,7 @@ void Label::setTextColor(const Color4B &color)
     if (_currentLabelType == LabelType::STRING_TEXTURE && _textColor != color)
     {
         _contentDirty = true;
+        markSubtreeDirty();
     }
 
     _textColor = color;
@@ -2148,6 +2164,7 @@ void Label::enableWrap(bool enable)
     this->rescaleWithOriginalFontSize();
     
     _contentDirty = true;
+    markSubtreeDirty();
 }
 
 bool Label::isWrapEnabled()const
@@ -2176,6 +2193,7 @@ void Label::setOverflow(Overflow overflow)
     this->rescaleWithOriginalFontSize();
     
     _contentDirty = true;
+    markSubtreeDirty();
 }
 
 void Label::rescaleWithOriginalFontSize()
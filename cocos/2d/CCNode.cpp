@@ -35,6 +35,7 @@ THE SOFTWARE.
 #include "base/CCDirector.h"
 #include "base/CCScheduler.h"
 #include "base/CCEventDispatcher.h"
+#include "base/CCJobSystem.h"
 #include "base/ccUTF8.h"
 #include "2d/CCCamera.h"
 #include "2d/CCActionManager.h"
@@ -43,6 +44,7 @@ THE SOFTWARE.
 #include "renderer/CCGLProgram.h"
 #include "renderer/CCGLProgramState.h"
 #include "renderer/CCMaterial.h"
+#include "renderer/CCRenderer.h"
 #include "math/TransformUtils.h"
 
 
@@ -57,6 +59,16 @@ NS_CC_BEGIN
 
 // FIXME:: Yes, nodes might have a sort problem once every 30 days if the game runs at 60 FPS and each frame sprites are reordered.
 unsigned int Node::s_globalOrderOfArrival = 0;
+unsigned int Node::s_retainedRenderingCount = 0;
+
+// Render commands of a subtree, replayed while nothing changes in it
+struct Node::RetainedRendering
+{
+    std::vector<Renderer::RecordedCommand> commands;
+    // the commands depend on the camera culling
+    const Camera* camera;
+    bool dirty;
+};
 int Node::__attachedNodeCount = 0;
 
 // MARK: Constructor, Destructor, Init
@@ -81,11 +93,13 @@ Node::Node()
 , _additionalTransform(nullptr)
 , _additionalTransformDirty(false)
 , _transformUpdated(true)
+, _transformPrecomputed(false)
 // children (lazy allocs)
 // lazy alloc
 , _localZOrderAndArrival(0)
 , _localZOrder(0)
 , _globalZOrder(0)
+, _retainedRendering(nullptr)
 , _parent(nullptr)
 // "whole screen" objects. like Scenes and Layers, should set _ignoreAnchorPointForPosition to true
 , _tag(Node::INVALID_TAG)
@@ -168,6 +182,12 @@ Node::~Node()
     // attributes
     CC_SAFE_RELEASE_NULL(_glProgramState);
 
+    if (_retainedRendering)
+    {
+        delete _retainedRendering;
+        --s_retainedRenderingCount;
+    }
+
     for (auto& child : _children)
     {
         child->_parent = nullptr;
@@ -243,6 +263,7 @@ void Node::setSkewX(float skewX)
     
     _skewX = skewX;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeDirty();
 }
 
 float Node::getSkewY() const
@@ -257,6 +278,7 @@ void Node::setSkewY(float skewY)
     
     _skewY = skewY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeDirty();
 }
 
 void Node::setLocalZOrder(int z)
@@ -292,6 +314,7 @@ void Node::setGlobalZOrder(float globalZOrder)
     {
         _globalZOrder = globalZOrder;
         _eventDispatcher->setDirtyForNode(this);
+        markSubtreeDirty();
     }
 }
 
@@ -310,6 +333,7 @@ void Node::setRotation(float rotation)
     
     _rotationZ_X = _rotationZ_Y = rotation;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeDirty();
     
     updateRotationQuat();
 }
@@ -327,6 +351,7 @@ void Node::setRotation3D(const Vec3& rotation)
         return;
     
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeDirty();
 
     _rotationX = rotation.x;
     _rotationY = rotation.y;
@@ -378,6 +403,7 @@ void Node::setRotationQuat(const Quaternion& quat)
     _rotationQuat = quat;
     updateRotation3D();
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeDirty();
 }
 
 Quaternion Node::getRotationQuat() const
@@ -392,6 +418,7 @@ void Node::setRotationSkewX(float rotationX)
     
     _rotationZ_X = rotationX;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeDirty();
     
     updateRotationQuat();
 }
@@ -408,6 +435,7 @@ void Node::setRotationSkewY(float rotationY)
     
     _rotationZ_Y = rotationY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeDirty();
     
     updateRotationQuat();
 }
@@ -427,6 +455,7 @@ void Node::setScale(float scale)
     
     _scaleX = _scaleY = _scaleZ = scale;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeDirty();
 }
 
 /// scaleX getter
@@ -444,6 +473,7 @@ void Node::setScale(float scaleX,float scaleY)
     _scaleX = scaleX;
     _scaleY = scaleY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeDirty();
 }
 
 /// scaleX setter
@@ -454,6 +484,7 @@ void Node::setScaleX(float scaleX)
     
     _scaleX = scaleX;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeDirty();
 }
 
 /// scaleY getter
@@ -470,6 +501,7 @@ void Node::setScaleZ(float scaleZ)
     
     _scaleZ = scaleZ;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeDirty();
 }
 
 /// scaleY getter
@@ -486,6 +518,7 @@ void Node::setScaleY(float scaleY)
     
     _scaleY = scaleY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeDirty();
 }
 
 
@@ -516,6 +549,7 @@ void Node::setPosition(float x, float y)
     _position.y = y;
     
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeDirty();
     _usingNormalizedPosition = false;
 }
 
@@ -561,6 +595,7 @@ void Node::setPositionZ(float positionZ)
         return;
     
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeDirty();
 
     _positionZ = positionZ;
 }
@@ -581,6 +616,7 @@ void Node::setPositionNormalized(const Vec2& position)
     _usingNormalizedPosition = true;
     _normalizedPositionDirty = true;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeDirty();
 }
 
 ssize_t Node::getChildrenCount() const
@@ -602,6 +638,7 @@ void Node::setVisible(bool visible)
         _visible = visible;
         if(_visible)
             _transformUpdated = _transformDirty = _inverseDirty = true;
+        markSubtreeDirty();
     }
 }
 
@@ -623,6 +660,7 @@ void Node::setAnchorPoint(const Vec2& point)
         _anchorPoint = point;
         _anchorPointInPoints.set(_contentSize.width * _anchorPoint.x, _contentSize.height * _anchorPoint.y);
         _transformUpdated = _transformDirty = _inverseDirty = true;
+        markSubtreeDirty();
     }
 }
 
@@ -640,6 +678,7 @@ void Node::setContentSize(const Size & size)
 
         _anchorPointInPoints.set(_contentSize.width * _anchorPoint.x, _contentSize.height * _anchorPoint.y);
         _transformUpdated = _transformDirty = _inverseDirty = _contentSizeDirty = true;
+        markSubtreeDirty();
     }
 }
 
@@ -654,6 +693,7 @@ void Node::setParent(Node * parent)
 {
     _parent = parent;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    markSubtreeDirty();
 }
 
 /// isRelativeAnchorPoint getter
@@ -669,6 +709,7 @@ void Node::setIgnoreAnchorPointForPosition(bool newValue)
     {
         _ignoreAnchorPointForPosition = newValue;
         _transformUpdated = _transformDirty = _inverseDirty = true;
+        markSubtreeDirty();
     }
 }
 
@@ -738,6 +779,8 @@ void Node::setGLProgramState(cocos2d::GLProgramState* glProgramState)
 
         if (_glProgramState)
             _glProgramState->setNodeBinding(this);
+
+        markSubtreeDirty();
     }
 }
 
@@ -1113,6 +1156,7 @@ void Node::removeAllChildrenWithCleanup(bool cleanup)
     }
     
     _children.clear();
+    markSubtreeDirty();
 }
 
 void Node::detachChild(Node *child, ssize_t childIndex, bool doCleanup)
@@ -1144,6 +1188,7 @@ void Node::detachChild(Node *child, ssize_t childIndex, bool doCleanup)
     child->setParent(nullptr);
 
     _children.erase(childIndex);
+    markSubtreeDirty();
 }
 
 
@@ -1161,6 +1206,7 @@ void Node::insertChild(Node* child, int z)
     _reorderChildDirty = true;
     _children.pushBack(child);
     child->_setLocalZOrder(z);
+    markSubtreeDirty();
 }
 
 void Node::reorderChild(Node *child, int zOrder)
@@ -1169,6 +1215,7 @@ void Node::reorderChild(Node *child, int zOrder)
     _reorderChildDirty = true;
     child->updateOrderOfArrival();
     child->_setLocalZOrder(zOrder);
+    markSubtreeDirty();
 }
 
 void Node::sortAllChildren()
@@ -1226,10 +1273,26 @@ uint32_t Node::processParentFlags(const Mat4& parentTransform, uint32_t parentFl
     
 
     if(flags & FLAGS_DIRTY_MASK)
-        _modelViewTransform = this->transform(parentTransform);
+    {
+        // updateTransforms() already did it, unless this node or its parent transform changed since
+        bool precomputed = _transformPrecomputed && !_transformDirty && !_additionalTransformDirty
+            && _parent && &parentTransform == &_parent->_modelViewTransform;
+        if (!precomputed)
+        {
+            Mat4 modelViewTransform = this->transform(parentTransform);
+            if (memcmp(modelViewTransform.m, _modelViewTransform.m, sizeof(modelViewTransform.m)) != 0)
+            {
+                _modelViewTransform = modelViewTransform;
+                // the children transforms were computed from the previous one
+                for (const auto& child : _children)
+                    child->_transformPrecomputed = false;
+            }
+        }
+    }
     
     _transformUpdated = false;
     _contentSizeDirty = false;
+    _transformPrecomputed = false;
 
     return flags;
 }
@@ -1251,6 +1314,22 @@ void Node::visit(Renderer* renderer, const Mat4 &parentTransform, uint32_t paren
 
     uint32_t flags = processParentFlags(parentTransform, parentFlags);
 
+    // replay the retained commands when nothing changed, otherwise record them while visiting
+    if (_retainedRendering)
+    {
+        auto camera = Camera::getVisitingCamera();
+        if (!_retainedRendering->dirty && !(flags & FLAGS_DIRTY_MASK) && _retainedRendering->camera == camera
+            && (!camera || !camera->isViewProjectionUpdated()))
+        {
+            renderer->replayCommands(_retainedRendering->commands);
+            return;
+        }
+
+        _retainedRendering->commands.clear();
+        _retainedRendering->camera = camera;
+        renderer->pushCommandRecorder(&_retainedRendering->commands);
+    }
+
     // IMPORTANT:
     // To ease the migration to v3.0, we still support the Mat4 stack,
     // but it is deprecated and your code should not rely on it
@@ -1287,6 +1366,13 @@ void Node::visit(Renderer* renderer, const Mat4 &parentTransform, uint32_t paren
     }
 
     _director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+
+    if (_retainedRendering)
+    {
+        renderer->popCommandRecorder();
+        // changes made while visiting are already part of the commands
+        _retainedRendering->dirty = false;
+    }
     
     // FIX ME: Why need to set _orderOfArrival to 0??
     // Please refer to https://github.com/cocos2d/cocos2d-x/pull/6920
@@ -1294,6 +1380,105 @@ void Node::visit(Renderer* renderer, const Mat4 &parentTransform, uint32_t paren
     // _orderOfArrival = 0;
 }
 
+void Node::updateTransforms(const Mat4& parentTransform)
+{
+    auto jobSystem = JobSystem::getInstance();
+    if (!_visible || jobSystem->getWorkerCount() == 0)
+        return;
+
+    // Same rules as processParentFlags(). The root is recomputed by visit() anyway, as its parent is unknown.
+    const bool dirty = _transformUpdated || _contentSizeDirty;
+    if (dirty)
+        _modelViewTransform = this->transform(parentTransform);
+
+    // Process the top of the tree on this thread, until there are enough subtrees to share between the threads
+    const size_t subtreesTarget = (jobSystem->getWorkerCount() + 1) * 4;
+    std::vector<std::pair<Node*, bool>> subtrees(1, std::make_pair(this, dirty));
+    std::vector<std::pair<Node*, bool>> nextSubtrees;
+    while (!subtrees.empty() && subtrees.size() < subtreesTarget)
+    {
+        nextSubtrees.clear();
+        for (const auto& subtree : subtrees)
+        {
+            Node* parent = subtree.first;
+            for (const auto& child : parent->_children)
+            {
+                if (!child->_visible || !child->isTransformPrecomputable())
+                    continue;
+
+                const bool childDirty = subtree.second || child->_transformUpdated || child->_contentSizeDirty;
+                if (childDirty)
+                {
+                    child->_modelViewTransform = child->transform(parent->_modelViewTransform);
+                    child->_transformPrecomputed = true;
+                }
+                if (!child->_children.empty())
+                    nextSubtrees.push_back(std::make_pair(child, childDirty));
+            }
+        }
+        subtrees.swap(nextSubtrees);
+    }
+
+    // The subtrees don't share any node: their transforms are computed in parallel
+    jobSystem->parallelFor(subtrees.size(), 1, [&subtrees](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            subtrees[i].first->precomputeTransforms(subtrees[i].second);
+        }
+    });
+}
+
+void Node::setRetainedRenderingEnabled(bool enabled)
+{
+    if (enabled == (_retainedRendering != nullptr))
+        return;
+
+    if (enabled)
+    {
+        _retainedRendering = new (std::nothrow) RetainedRendering();
+        _retainedRendering->camera = nullptr;
+        _retainedRendering->dirty = true;
+        ++s_retainedRenderingCount;
+    }
+    else
+    {
+        delete _retainedRendering;
+        _retainedRendering = nullptr;
+        --s_retainedRenderingCount;
+    }
+}
+
+void Node::markSubtreeDirty()
+{
+    // most scenes don't use retained rendering: don't walk up the tree for nothing
+    if (s_retainedRenderingCount == 0)
+        return;
+
+    for (Node* node = this; node != nullptr; node = node->_parent)
+    {
+        if (node->_retainedRendering)
+            node->_retainedRendering->dirty = true;
+    }
+}
+
+void Node::precomputeTransforms(bool parentDirty)
+{
+    for (const auto& child : _children)
+    {
+        // invisible nodes are not visited, nor their children. The others are left to visit()
+        if (!child->_visible || !child->isTransformPrecomputable())
+            continue;
+
+        const bool dirty = parentDirty || child->_transformUpdated || child->_contentSizeDirty;
+        if (dirty)
+        {
+            child->_modelViewTransform = child->transform(_modelViewTransform);
+            child->_transformPrecomputed = true;
+        }
+        child->precomputeTransforms(dirty);
+    }
+}
+
 Mat4 Node::transform(const Mat4& parentTransform)
 {
     return parentTransform * this->getNodeToParentTransform();
@@ -1815,6 +2000,7 @@ void Node::setNodeToParentTransform(const Mat4& transform)
     _transform = transform;
     _transformDirty = false;
     _transformUpdated = true;
+    markSubtreeDirty();
 
     if (_additionalTransform)
         // _additionalTransform[1] has a copy of lastest transform
@@ -1848,6 +2034,7 @@ void Node::setAdditionalTransform(const Mat4* additionalTransform)
         _additionalTransform[0] = *additionalTransform;
     }
     _transformUpdated = _additionalTransformDirty = _inverseDirty = true;
+    markSubtreeDirty();
 }
 
 void Node::setAdditionalTransform(const Mat4& additionalTransform)
@@ -2020,6 +2207,7 @@ void Node::updateDisplayedOpacity(GLubyte parentOpacity)
 {
     _displayedOpacity = _realOpacity * parentOpacity/255.0;
     updateColor();
+    markSubtreeDirty();
     
     if (_cascadeOpacityEnabled)
     {
@@ -2107,6 +2295,7 @@ void Node::updateDisplayedColor(const Color3B& parentColor)
     _displayedColor.g = _realColor.g * parentColor.g/255.0;
     _displayedColor.b = _realColor.b * parentColor.b/255.0;
     updateColor();
+    markSubtreeDirty();
     
     if (_cascadeColorEnabled)
     {
@@ -2210,6 +2399,7 @@ bool isScreenPointInRect(const Vec2 &pt, const Camera* camera, const Mat4& w2l,
 void Node::setCameraMask(unsigned short mask, bool applyChildren)
 {
     _cameraMask = mask;
+    markSubtreeDirty();
     if (applyChildren)
     {
         for (const auto& child : _children)
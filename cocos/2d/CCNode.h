@@ -1179,6 +1179,45 @@ public:
     virtual void visit(Renderer *renderer, const Mat4& parentTransform, uint32_t parentFlags);
     virtual void visit() final;
 
+    /**
+     * Computes the model view transform of the dirty nodes of this subtree before it is visited,
+     * processing independent subtrees in parallel with the JobSystem.
+     * visit() then reuses them, and only recomputes the transforms changed in the meantime.
+     * Transforms changed from another node's draw() while visiting must be changed
+     * with the node setters, not by calling setNodeToParentTransform() on a visited node.
+     * AttachNode subtrees are skipped, as the bones they follow are updated while visiting.
+     *
+     * @param parentTransform The transform that will be passed to visit().
+     * @since v3.17
+     */
+    void updateTransforms(const Mat4& parentTransform);
+
+    /**
+     * Enables/Disables retained rendering for this node and its children.
+     * Once the subtree has been visited, its render commands are replayed each frame without visiting it,
+     * until a node of the subtree changes: transform, color, opacity, visibility, z-order, children,
+     * shader, camera mask, the texture, geometry or flipping of a Sprite, the content of a Label or
+     * a DrawNode, or a running particle system, which is visited again every frame.
+     * Use it for static branches such as backgrounds or HUDs, and call markSubtreeDirty() when the content
+     * of another kind of node changes without going through these setters.
+     * It is implemented by Node::visit(), so it has no effect on nodes overriding visit() without calling it.
+     *
+     * @param enabled Whether or not the render commands of the subtree are retained.
+     * @since v3.17
+     */
+    void setRetainedRenderingEnabled(bool enabled);
+
+    /** Whether or not the render commands of this subtree are retained.
+     * @since v3.17
+     */
+    bool isRetainedRenderingEnabled() const { return _retainedRendering != nullptr; }
+
+    /** Tells the retained subtrees containing this node that they must be visited again.
+     * The node setters call it, call it when a node is changed another way.
+     * @since v3.17
+     */
+    void markSubtreeDirty();
+
 
     /** Returns the Scene that contains the Node.
      It returns `nullptr` if the node doesn't belong to any Scene.
@@ -1878,6 +1917,11 @@ protected:
 
     Mat4 transform(const Mat4 &parentTransform);
     uint32_t processParentFlags(const Mat4& parentTransform, uint32_t parentFlags);
+    // Computes the transforms of the dirty children of this node, recursively. See updateTransforms()
+    void precomputeTransforms(bool parentDirty);
+    // false when the transform depends on something updated while visiting, like a bone of a
+    // Sprite3D: updateTransforms() then skips the node and its children, visit() computes them
+    virtual bool isTransformPrecomputable() const { return true; }
 
     virtual void updateCascadeOpacity();
     virtual void disableCascadeOpacity();
@@ -1939,6 +1983,7 @@ protected:
     mutable Mat4* _additionalTransform; ///< two transforms needed by additional transforms
     mutable bool _additionalTransformDirty; ///< transform dirty ?
     bool _transformUpdated;         ///< Whether or not the Transform object was updated since the last frame
+    bool _transformPrecomputed;     ///< Whether or not updateTransforms() computed _modelViewTransform for the next visit
 
     std::int64_t _localZOrderAndArrival; /// cache, for 64bits compress optimize.
     int _localZOrder; /// < Local order (relative to its siblings) used to sort the node
@@ -1947,6 +1992,10 @@ protected:
 
     static unsigned int s_globalOrderOfArrival;
 
+    struct RetainedRendering;
+    RetainedRendering* _retainedRendering; ///< render commands of the subtree, when retained rendering is enabled
+    static unsigned int s_retainedRenderingCount; ///< number of nodes with retained rendering
+
     Vector<Node*> _children;        ///< array of children nodes
     Node *_parent;                  ///< weak reference to parent node
     Director* _director;            //cached director pointer to improve rendering performance
@@ -55,6 +55,16 @@ THE SOFTWARE.
 #include "base/ccUTF8.h"
 #include "renderer/CCTextureCache.h"
 #include "platform/CCFileUtils.h"
+#include "base/CCJobSystem.h"
+#include "2d/CCParticleSystemManager.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE__)
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 using namespace std;
 
@@ -78,21 +88,178 @@ NS_CC_BEGIN
 //
 
 
-inline void normalize_point(float x, float y, particle_point* out)
+// Update kernels, on the structure-of-arrays ParticleData.
+// Each one processes [begin, end) with AVX (8 particles), SSE or NEON (4 particles), and the remaining ones in plain C.
+
+// dst += src * scale
+static void particleAddScaled(float* dst, const float* src, float scale, int begin, int end)
 {
-    float n = x * x + y * y;
-    // Already normalized.
-    if (n == 1.0f)
-        return;
-    
-    n = sqrt(n);
-    // Too close to zero.
-    if (n < MATH_TOLERANCE)
-        return;
-    
-    n = 1.0f / n;
-    out->x = x * n;
-    out->y = y * n;
+    int i = begin;
+#if defined(__AVX__)
+    const __m256 s8 = _mm256_set1_ps(scale);
+    for (; i + 8 <= end; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), s8)));
+#endif
+#if defined(__SSE__)
+    const __m128 s4 = _mm_set1_ps(scale);
+    for (; i + 4 <= end; i += 4)
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), s4)));
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    const float32x4_t s4 = vdupq_n_f32(scale);
+    for (; i + 4 <= end; i += 4)
+        vst1q_f32(dst + i, vmlaq_f32(vld1q_f32(dst + i), vld1q_f32(src + i), s4));
+#endif
+    for (; i < end; ++i)
+        dst[i] += src[i] * scale;
+}
+
+// dst = max(dst + src * scale, 0)
+static void particleAddScaledPositive(float* dst, const float* src, float scale, int begin, int end)
+{
+    int i = begin;
+#if defined(__AVX__)
+    const __m256 s8 = _mm256_set1_ps(scale);
+    const __m256 zero8 = _mm256_setzero_ps();
+    for (; i + 8 <= end; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_max_ps(_mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), s8)), zero8));
+#endif
+#if defined(__SSE__)
+    const __m128 s4 = _mm_set1_ps(scale);
+    const __m128 zero4 = _mm_setzero_ps();
+    for (; i + 4 <= end; i += 4)
+        _mm_storeu_ps(dst + i, _mm_max_ps(_mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), s4)), zero4));
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    const float32x4_t s4 = vdupq_n_f32(scale);
+    const float32x4_t zero4 = vdupq_n_f32(0.0f);
+    for (; i + 4 <= end; i += 4)
+        vst1q_f32(dst + i, vmaxq_f32(vmlaq_f32(vld1q_f32(dst + i), vld1q_f32(src + i), s4), zero4));
+#endif
+    for (; i < end; ++i)
+        dst[i] = MAX(0, dst[i] + src[i] * scale);
+}
+
+// Gravity mode: the radial and tangential accelerations are along the normalized position,
+// which is (0, 0) when the particle is at the origin.
+static void particleIntegrateGravity(ParticleData& data, const Vec2& gravity, float dt, float yCoordFlipped, int begin, int end)
+{
+    float* posx = data.posx;
+    float* posy = data.posy;
+    float* dirX = data.modeA.dirX;
+    float* dirY = data.modeA.dirY;
+    const float* radialAccel = data.modeA.radialAccel;
+    const float* tangentialAccel = data.modeA.tangentialAccel;
+    const float moveScale = dt * yCoordFlipped;
+
+    int i = begin;
+#if defined(__AVX__)
+    {
+        const __m256 gx = _mm256_set1_ps(gravity.x), gy = _mm256_set1_ps(gravity.y);
+        const __m256 t = _mm256_set1_ps(dt), m = _mm256_set1_ps(moveScale);
+        const __m256 one = _mm256_set1_ps(1.0f), zero = _mm256_setzero_ps();
+        for (; i + 8 <= end; i += 8)
+        {
+            __m256 x = _mm256_loadu_ps(posx + i);
+            __m256 y = _mm256_loadu_ps(posy + i);
+            __m256 len2 = _mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y));
+            __m256 valid = _mm256_cmp_ps(len2, zero, _CMP_GT_OQ);
+            __m256 inv = _mm256_div_ps(one, _mm256_sqrt_ps(len2));
+            __m256 rx = _mm256_and_ps(valid, _mm256_mul_ps(x, inv));
+            __m256 ry = _mm256_and_ps(valid, _mm256_mul_ps(y, inv));
+            __m256 ra = _mm256_loadu_ps(radialAccel + i);
+            __m256 ta = _mm256_loadu_ps(tangentialAccel + i);
+            __m256 ax = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(rx, ra), _mm256_mul_ps(ry, ta)), gx);
+            __m256 ay = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ry, ra), _mm256_mul_ps(rx, ta)), gy);
+            __m256 dx = _mm256_add_ps(_mm256_loadu_ps(dirX + i), _mm256_mul_ps(ax, t));
+            __m256 dy = _mm256_add_ps(_mm256_loadu_ps(dirY + i), _mm256_mul_ps(ay, t));
+            _mm256_storeu_ps(dirX + i, dx);
+            _mm256_storeu_ps(dirY + i, dy);
+            _mm256_storeu_ps(posx + i, _mm256_add_ps(x, _mm256_mul_ps(dx, m)));
+            _mm256_storeu_ps(posy + i, _mm256_add_ps(y, _mm256_mul_ps(dy, m)));
+        }
+    }
+#endif
+#if defined(__SSE__)
+    {
+        const __m128 gx = _mm_set1_ps(gravity.x), gy = _mm_set1_ps(gravity.y);
+        const __m128 t = _mm_set1_ps(dt), m = _mm_set1_ps(moveScale);
+        const __m128 one = _mm_set1_ps(1.0f), zero = _mm_setzero_ps();
+        for (; i + 4 <= end; i += 4)
+        {
+            __m128 x = _mm_loadu_ps(posx + i);
+            __m128 y = _mm_loadu_ps(posy + i);
+            __m128 len2 = _mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y));
+            __m128 valid = _mm_cmpgt_ps(len2, zero);
+            __m128 inv = _mm_div_ps(one, _mm_sqrt_ps(len2));
+            __m128 rx = _mm_and_ps(valid, _mm_mul_ps(x, inv));
+            __m128 ry = _mm_and_ps(valid, _mm_mul_ps(y, inv));
+            __m128 ra = _mm_loadu_ps(radialAccel + i);
+            __m128 ta = _mm_loadu_ps(tangentialAccel + i);
+            __m128 ax = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rx, ra), _mm_mul_ps(ry, ta)), gx);
+            __m128 ay = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ry, ra), _mm_mul_ps(rx, ta)), gy);
+            __m128 dx = _mm_add_ps(_mm_loadu_ps(dirX + i), _mm_mul_ps(ax, t));
+            __m128 dy = _mm_add_ps(_mm_loadu_ps(dirY + i), _mm_mul_ps(ay, t));
+            _mm_storeu_ps(dirX + i, dx);
+            _mm_storeu_ps(dirY + i, dy);
+            _mm_storeu_ps(posx + i, _mm_add_ps(x, _mm_mul_ps(dx, m)));
+            _mm_storeu_ps(posy + i, _mm_add_ps(y, _mm_mul_ps(dy, m)));
+        }
+    }
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    {
+        const float32x4_t gx = vdupq_n_f32(gravity.x), gy = vdupq_n_f32(gravity.y);
+        const float32x4_t t = vdupq_n_f32(dt), m = vdupq_n_f32(moveScale);
+        const float32x4_t zero = vdupq_n_f32(0.0f);
+        for (; i + 4 <= end; i += 4)
+        {
+            float32x4_t x = vld1q_f32(posx + i);
+            float32x4_t y = vld1q_f32(posy + i);
+            float32x4_t len2 = vmlaq_f32(vmulq_f32(x, x), y, y);
+            uint32x4_t valid = vcgtq_f32(len2, zero);
+            // reciprocal square root estimate, refined by two Newton-Raphson steps
+            float32x4_t inv = vrsqrteq_f32(len2);
+            inv = vmulq_f32(inv, vrsqrtsq_f32(vmulq_f32(len2, inv), inv));
+            inv = vmulq_f32(inv, vrsqrtsq_f32(vmulq_f32(len2, inv), inv));
+            float32x4_t rx = vreinterpretq_f32_u32(vandq_u32(valid, vreinterpretq_u32_f32(vmulq_f32(x, inv))));
+            float32x4_t ry = vreinterpretq_f32_u32(vandq_u32(valid, vreinterpretq_u32_f32(vmulq_f32(y, inv))));
+            float32x4_t ra = vld1q_f32(radialAccel + i);
+            float32x4_t ta = vld1q_f32(tangentialAccel + i);
+            float32x4_t ax = vaddq_f32(vmlsq_f32(vmulq_f32(rx, ra), ry, ta), gx);
+            float32x4_t ay = vaddq_f32(vmlaq_f32(vmulq_f32(ry, ra), rx, ta), gy);
+            float32x4_t dx = vmlaq_f32(vld1q_f32(dirX + i), ax, t);
+            float32x4_t dy = vmlaq_f32(vld1q_f32(dirY + i), ay, t);
+            vst1q_f32(dirX + i, dx);
+            vst1q_f32(dirY + i, dy);
+            vst1q_f32(posx + i, vmlaq_f32(x, dx, m));
+            vst1q_f32(posy + i, vmlaq_f32(y, dy, m));
+        }
+    }
+#endif
+    for (; i < end; ++i)
+    {
+        float rx = 0.0f, ry = 0.0f;
+        float len2 = posx[i] * posx[i] + posy[i] * posy[i];
+        if (len2 > 0.0f)
+        {
+            float inv = 1.0f / sqrtf(len2);
+            rx = posx[i] * inv;
+            ry = posy[i] * inv;
+        }
+        // (gravity + radial + tangential) * dt
+        float ax = rx * radialAccel[i] - ry * tangentialAccel[i] + gravity.x;
+        float ay = ry * radialAccel[i] + rx * tangentialAccel[i] + gravity.y;
+        dirX[i] += ax * dt;
+        dirY[i] += ay * dt;
+        posx[i] += dirX[i] * moveScale;
+        posy[i] += dirY[i] * moveScale;
+    }
+}
+
+// data[k] = data[indices[k]] for k in [begin, end), with indices[k] >= k
+template <typename T>
+static void particleGather(T* data, const unsigned int* indices, int begin, int end)
+{
+    for (int k = begin; k < end; ++k)
+        data[k] = data[indices[k]];
 }
 
 /**
@@ -135,6 +302,7 @@ bool ParticleData::init(int count)
     deltaRotation= (float*)malloc(count * sizeof(float));
     timeToLive= (float*)malloc(count * sizeof(float));
     atlasIndex= (unsigned int*)malloc(count * sizeof(unsigned int));
+    compactIndex= (unsigned int*)malloc(count * sizeof(unsigned int));
     
     modeA.dirX= (float*)malloc(count * sizeof(float));
     modeA.dirY= (float*)malloc(count * sizeof(float));
@@ -148,7 +316,7 @@ bool ParticleData::init(int count)
     
     return posx && posy && startPosY && startPosX && colorR && colorG && colorB && colorA &&
     deltaColorR && deltaColorG && deltaColorB && deltaColorA && size && deltaSize &&
-    rotation && deltaRotation && timeToLive && atlasIndex && modeA.dirX && modeA.dirY &&
+    rotation && deltaRotation && timeToLive && atlasIndex && compactIndex && modeA.dirX && modeA.dirY &&
     modeA.radialAccel && modeA.tangentialAccel && modeB.angle && modeB.degreesPerSecond &&
     modeB.deltaRadius && modeB.radius;
 }
@@ -173,6 +341,7 @@ void ParticleData::release()
     CC_SAFE_FREE(deltaRotation);
     CC_SAFE_FREE(timeToLive);
     CC_SAFE_FREE(atlasIndex);
+    CC_SAFE_FREE(compactIndex);
     
     CC_SAFE_FREE(modeA.dirX);
     CC_SAFE_FREE(modeA.dirY);
@@ -223,6 +392,7 @@ ParticleSystem::ParticleSystem()
 , _yCoordFlipped(1)
 , _positionType(PositionType::FREE)
 , _paused(false)
+, _isParallelUpdate(false)
 {
     modeA.gravity.setZero();
     modeA.speed = 0;
@@ -857,7 +1027,29 @@ bool ParticleSystem::isFull()
 void ParticleSystem::update(float dt)
 {
     CC_PROFILER_START_CATEGORY(kProfilerCategoryParticles , "CCParticleSystem - update");
+    // the particles move every frame, a retained subtree can't replay them
+    markSubtreeDirty();
+
+    updateEmission(dt);
 
+    auto manager = ParticleSystemManager::getInstance();
+    if (manager->isParallelUpdateEnabled())
+    {
+        // simulated later in the frame, together with the other emitters
+        manager->addEmitter(this, dt);
+    }
+    else
+    {
+        int particleCount = _particleCount;
+        simulate(dt);
+        finishUpdate(particleCount);
+    }
+
+    CC_PROFILER_STOP_CATEGORY(kProfilerCategoryParticles , "CCParticleSystem - update");
+}
+
+void ParticleSystem::updateEmission(float dt)
+{
     if (_isActive && _emissionRate)
     {
         float rate = 1.0f / _emissionRate;
@@ -883,152 +1075,155 @@ void ParticleSystem::update(float dt)
             this->stopSystem();
         }
     }
+}
+
+void ParticleSystem::simulate(float dt)
+{
+    for (int i = 0; i < _particleCount; ++i)
+    {
+        _particleData.timeToLive[i] -= dt;
+    }
+    
+    removeDeadParticles();
     
+    forEachParticleRange([this, dt](size_t begin, size_t end) {
+        updateParticles(dt, (int)begin, (int)end);
+    });
+    
+    updateParticleQuads();
+    _transformSystemDirty = false;
+}
+
+void ParticleSystem::finishUpdate(int previousParticleCount)
+{
+    if (_batchNode)
     {
-        for (int i = 0; i < _particleCount; ++i)
+        // the quads are filled in the particles order, so the atlas indexes stay in place
+        // and the quads after the live particles are disabled
+        for (int i = _particleCount; i < previousParticleCount; ++i)
         {
-            _particleData.timeToLive[i] -= dt;
-        }
-        
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            if (_particleData.timeToLive[i] <= 0.0f)
-            {
-                int j = _particleCount - 1;
-                while (j > 0 && _particleData.timeToLive[j] <= 0)
-                {
-                    _particleCount--;
-                    j--;
-                }
-                _particleData.copyParticle(i, _particleCount - 1);
-                if (_batchNode)
-                {
-                    //disable the switched particle
-                    int currentIndex = _particleData.atlasIndex[i];
-                    _batchNode->disableParticle(_atlasIndex + currentIndex);
-                    //switch indexes
-                    _particleData.atlasIndex[_particleCount - 1] = currentIndex;
-                }
-                --_particleCount;
-                if( _particleCount == 0 && _isAutoRemoveOnFinish )
-                {
-                    this->unscheduleUpdate();
-                    _parent->removeChild(this, true);
-                    return;
-                }
-            }
-        }
-        
-        if (_emitterMode == Mode::GRAVITY)
-        {
-            for (int i = 0 ; i < _particleCount; ++i)
-            {
-                particle_point tmp, radial = {0.0f, 0.0f}, tangential;
-                
-                // radial acceleration
-                if (_particleData.posx[i] || _particleData.posy[i])
-                {
-                    normalize_point(_particleData.posx[i], _particleData.posy[i], &radial);
-                }
-                tangential = radial;
-                radial.x *= _particleData.modeA.radialAccel[i];
-                radial.y *= _particleData.modeA.radialAccel[i];
-                
-                // tangential acceleration
-                std::swap(tangential.x, tangential.y);
-                tangential.x *= - _particleData.modeA.tangentialAccel[i];
-                tangential.y *= _particleData.modeA.tangentialAccel[i];
-                
-                // (gravity + radial + tangential) * dt
-                tmp.x = radial.x + tangential.x + modeA.gravity.x;
-                tmp.y = radial.y + tangential.y + modeA.gravity.y;
-                tmp.x *= dt;
-                tmp.y *= dt;
-                
-                _particleData.modeA.dirX[i] += tmp.x;
-                _particleData.modeA.dirY[i] += tmp.y;
-                
-                // this is cocos2d-x v3.0
-                // if (_configName.length()>0 && _yCoordFlipped != -1)
-                
-                // this is cocos2d-x v3.0
-                tmp.x = _particleData.modeA.dirX[i] * dt * _yCoordFlipped;
-                tmp.y = _particleData.modeA.dirY[i] * dt * _yCoordFlipped;
-                _particleData.posx[i] += tmp.x;
-                _particleData.posy[i] += tmp.y;
-            }
-        }
-        else
-        {
-            //Why use so many for-loop separately instead of putting them together?
-            //When the processor needs to read from or write to a location in memory,
-            //it first checks whether a copy of that data is in the cache.
-            //And every property's memory of the particle system is continuous,
-            //for the purpose of improving cache hit rate, we should process only one property in one for-loop AFAP.
-            //It was proved to be effective especially for low-end machine. 
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.modeB.angle[i] += _particleData.modeB.degreesPerSecond[i] * dt;
-            }
-            
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.modeB.radius[i] += _particleData.modeB.deltaRadius[i] * dt;
-            }
-            
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.posx[i] = - cosf(_particleData.modeB.angle[i]) * _particleData.modeB.radius[i];
-            }
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.posy[i] = - sinf(_particleData.modeB.angle[i]) * _particleData.modeB.radius[i] * _yCoordFlipped;
-            }
-        }
-        
-        //color r,g,b,a
-        for (int i = 0 ; i < _particleCount; ++i)
-        {
-            _particleData.colorR[i] += _particleData.deltaColorR[i] * dt;
-        }
-        
-        for (int i = 0 ; i < _particleCount; ++i)
-        {
-            _particleData.colorG[i] += _particleData.deltaColorG[i] * dt;
-        }
-        
-        for (int i = 0 ; i < _particleCount; ++i)
-        {
-            _particleData.colorB[i] += _particleData.deltaColorB[i] * dt;
+            _batchNode->disableParticle(_atlasIndex + _particleData.atlasIndex[i]);
         }
+    }
+    
+    if (_particleCount == 0 && previousParticleCount > 0 && _isAutoRemoveOnFinish)
+    {
+        this->unscheduleUpdate();
+        // a deferred update can finish after the emitter was removed
+        if (_parent)
+            _parent->removeChild(this, true);
+        return;
+    }
+
+    // only update gl buffer when visible
+    if (_visible && ! _batchNode)
+    {
+        postStep();
+    }
+}
+
+int ParticleSystem::removeDeadParticles()
+{
+    // most frames, no particle dies
+    int first = 0;
+    while (first < _particleCount && _particleData.timeToLive[first] > 0.0f)
+    {
+        ++first;
+    }
+    if (first == _particleCount)
+    {
+        return 0;
+    }
+    
+    // branch-free list of the live particles: each index is written, and kept only if alive
+    unsigned int* indices = _particleData.compactIndex;
+    int aliveCount = first;
+    for (int i = first; i < _particleCount; ++i)
+    {
+        indices[aliveCount] = i;
+        aliveCount += _particleData.timeToLive[i] > 0.0f;
+    }
+    const int deadCount = _particleCount - aliveCount;
+    
+    // move the live particles down, keeping their order
+    particleGather(_particleData.posx, indices, first, aliveCount);
+    particleGather(_particleData.posy, indices, first, aliveCount);
+    particleGather(_particleData.startPosX, indices, first, aliveCount);
+    particleGather(_particleData.startPosY, indices, first, aliveCount);
+    particleGather(_particleData.colorR, indices, first, aliveCount);
+    particleGather(_particleData.colorG, indices, first, aliveCount);
+    particleGather(_particleData.colorB, indices, first, aliveCount);
+    particleGather(_particleData.colorA, indices, first, aliveCount);
+    particleGather(_particleData.deltaColorR, indices, first, aliveCount);
+    particleGather(_particleData.deltaColorG, indices, first, aliveCount);
+    particleGather(_particleData.deltaColorB, indices, first, aliveCount);
+    particleGather(_particleData.deltaColorA, indices, first, aliveCount);
+    particleGather(_particleData.size, indices, first, aliveCount);
+    particleGather(_particleData.deltaSize, indices, first, aliveCount);
+    particleGather(_particleData.rotation, indices, first, aliveCount);
+    particleGather(_particleData.deltaRotation, indices, first, aliveCount);
+    particleGather(_particleData.timeToLive, indices, first, aliveCount);
+    particleGather(_particleData.modeA.dirX, indices, first, aliveCount);
+    particleGather(_particleData.modeA.dirY, indices, first, aliveCount);
+    particleGather(_particleData.modeA.radialAccel, indices, first, aliveCount);
+    particleGather(_particleData.modeA.tangentialAccel, indices, first, aliveCount);
+    particleGather(_particleData.modeB.angle, indices, first, aliveCount);
+    particleGather(_particleData.modeB.degreesPerSecond, indices, first, aliveCount);
+    particleGather(_particleData.modeB.radius, indices, first, aliveCount);
+    particleGather(_particleData.modeB.deltaRadius, indices, first, aliveCount);
+    
+    _particleCount = aliveCount;
+    return deadCount;
+}
+
+void ParticleSystem::updateParticles(float dt, int begin, int end)
+{
+    if (_emitterMode == Mode::GRAVITY)
+    {
+        particleIntegrateGravity(_particleData, modeA.gravity, dt, _yCoordFlipped, begin, end);
+    }
+    else
+    {
+        //Why use so many for-loop separately instead of putting them together?
+        //When the processor needs to read from or write to a location in memory,
+        //it first checks whether a copy of that data is in the cache.
+        //And every property's memory of the particle system is continuous,
+        //for the purpose of improving cache hit rate, we should process only one property in one for-loop AFAP.
+        //It was proved to be effective especially for low-end machine. 
+        particleAddScaled(_particleData.modeB.angle, _particleData.modeB.degreesPerSecond, dt, begin, end);
+        particleAddScaled(_particleData.modeB.radius, _particleData.modeB.deltaRadius, dt, begin, end);
         
-        for (int i = 0 ; i < _particleCount; ++i)
+        for (int i = begin; i < end; ++i)
         {
-            _particleData.colorA[i] += _particleData.deltaColorA[i] * dt;
+            _particleData.posx[i] = - cosf(_particleData.modeB.angle[i]) * _particleData.modeB.radius[i];
         }
-        //size
-        for (int i = 0 ; i < _particleCount; ++i)
+        for (int i = begin; i < end; ++i)
         {
-            _particleData.size[i] += (_particleData.deltaSize[i] * dt);
-            _particleData.size[i] = MAX(0, _particleData.size[i]);
+            _particleData.posy[i] = - sinf(_particleData.modeB.angle[i]) * _particleData.modeB.radius[i] * _yCoordFlipped;
         }
-        //angle
-        for (int i = 0 ; i < _particleCount; ++i)
-        {
-            _particleData.rotation[i] += _particleData.deltaRotation[i] * dt;
-        }
-        
-        updateParticleQuads();
-        _transformSystemDirty = false;
     }
+    
+    //color r,g,b,a
+    particleAddScaled(_particleData.colorR, _particleData.deltaColorR, dt, begin, end);
+    particleAddScaled(_particleData.colorG, _particleData.deltaColorG, dt, begin, end);
+    particleAddScaled(_particleData.colorB, _particleData.deltaColorB, dt, begin, end);
+    particleAddScaled(_particleData.colorA, _particleData.deltaColorA, dt, begin, end);
+    //size
+    particleAddScaledPositive(_particleData.size, _particleData.deltaSize, dt, begin, end);
+    //angle
+    particleAddScaled(_particleData.rotation, _particleData.deltaRotation, dt, begin, end);
+}
 
-    // only update gl buffer when visible
-    if (_visible && ! _batchNode)
+void ParticleSystem::forEachParticleRange(const std::function<void(size_t begin, size_t end)>& func)
+{
+    if (_isParallelUpdate && _particleCount >= PARALLEL_UPDATE_MIN_PARTICLES)
     {
-        postStep();
+        JobSystem::getInstance()->parallelFor(_particleCount, PARALLEL_UPDATE_MIN_PARTICLES / 2, func);
+    }
+    else if (_particleCount > 0)
+    {
+        func(0, _particleCount);
     }
-
-    CC_PROFILER_STOP_CATEGORY(kProfilerCategoryParticles , "CCParticleSystem - update");
 }
 
 void ParticleSystem::updateWithNoTime(void)
@@ -91,6 +91,9 @@ public:
         float* deltaRadius;
     } modeB;
     
+    //! scratch indices used to remove the dead particles
+    unsigned int* compactIndex;
+    
     unsigned int maxCount;
     ParticleData();
     bool init(int count);
@@ -291,6 +294,22 @@ public:
      */
     virtual void setAutoRemoveOnFinish(bool var);
 
+    /** Sets whether the particles are updated on several threads, with the JobSystem workers.
+     * Only the emitters with at least PARALLEL_UPDATE_MIN_PARTICLES live particles are split. Disabled by default.
+     *
+     * @param enabled True to split the update of large emitters across threads.
+     * @since v3.17
+     */
+    void setParallelUpdateEnabled(bool enabled) { _isParallelUpdate = enabled; }
+
+    /** Whether the particles are updated on several threads.
+     * @since v3.17
+     */
+    bool isParallelUpdateEnabled() const { return _isParallelUpdate; }
+
+    /** The number of live particles from which the update is split across threads. */
+    static const int PARALLEL_UPDATE_MIN_PARTICLES = 2048;
+
     // mode A
     /** Gets the gravity.
      *
@@ -819,9 +838,36 @@ CC_CONSTRUCTOR_ACCESS:
 
 protected:
     virtual void updateBlendFunc();
+
+    /** Emits the new particles, stops the system once its duration is over. */
+    void updateEmission(float dt);
+
+    /** Moves the particles and fills their quads, without changing anything outside of the particle system.
+     * It can run on any thread, see ParticleSystemManager.
+     */
+    void simulate(float dt);
+
+    /** Disables the batch node quads of the dead particles, removes the system if finished, and uploads the VBO.
+     *
+     * @param previousParticleCount The particle count before simulate().
+     */
+    void finishUpdate(int previousParticleCount);
+
+    /** Removes the particles whose time to live is over, keeping the order of the live ones.
+     *
+     * @return The number of removed particles.
+     */
+    int removeDeadParticles();
+
+    /** Moves, colors, resizes and rotates the particles in [begin, end). */
+    void updateParticles(float dt, int begin, int end);
+
+    /** Runs func on the live particles, split across threads if the parallel update is enabled and the emitter is large enough. */
+    void forEachParticleRange(const std::function<void(size_t begin, size_t end)>& func);
     
 private:
     friend class EngineDataManager;
+    friend class ParticleSystemManager;
     /** Internal use only, it's used by EngineDataManager class for Android platform */
     static void setTotalParticleCountFactor(float factor);
     
@@ -985,6 +1031,9 @@ protected:
     /** is the emitter paused */
     bool _paused;
 
+    /** whether large emitters are updated on several threads */
+    bool _isParallelUpdate;
+
     static Vector<ParticleSystem*> __allInstances;
     
 private:
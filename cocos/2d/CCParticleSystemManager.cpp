@@ -0,0 +1,133 @@
+/****************************************************************************
+Copyright (c) 2017 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "2d/CCParticleSystemManager.h"
+#include "2d/CCParticleSystem.h"
+#include "base/CCDirector.h"
+#include "base/CCScheduler.h"
+#include "base/CCJobSystem.h"
+
+NS_CC_BEGIN
+
+static const std::string UPDATE_KEY = "ParticleSystemManager";
+
+ParticleSystemManager* ParticleSystemManager::s_sharedParticleSystemManager = nullptr;
+
+ParticleSystemManager* ParticleSystemManager::getInstance()
+{
+    if (s_sharedParticleSystemManager == nullptr)
+    {
+        s_sharedParticleSystemManager = new (std::nothrow) ParticleSystemManager();
+    }
+    return s_sharedParticleSystemManager;
+}
+
+void ParticleSystemManager::destroyInstance()
+{
+    delete s_sharedParticleSystemManager;
+    s_sharedParticleSystemManager = nullptr;
+}
+
+ParticleSystemManager::ParticleSystemManager()
+: _isParallelUpdate(false)
+{
+}
+
+ParticleSystemManager::~ParticleSystemManager()
+{
+    setParallelUpdateEnabled(false);
+}
+
+void ParticleSystemManager::setParallelUpdateEnabled(bool enabled)
+{
+    if (_isParallelUpdate == enabled)
+        return;
+
+    _isParallelUpdate = enabled;
+    auto scheduler = Director::getInstance()->getScheduler();
+    if (enabled)
+    {
+        // timers are run after the node updates, so the emitters of the frame are all queued
+        scheduler->schedule(CC_CALLBACK_1(ParticleSystemManager::update, this), this, 0, false, UPDATE_KEY);
+    }
+    else
+    {
+        scheduler->unschedule(UPDATE_KEY, this);
+        update(0);
+    }
+}
+
+void ParticleSystemManager::addEmitter(ParticleSystem* system, float dt)
+{
+    system->retain();
+    _emitters.push_back({ system, dt, 0 });
+}
+
+void ParticleSystemManager::update(float /*dt*/)
+{
+    // emitters removed from their parent earlier in the frame are only released
+    for (auto it = _emitters.begin(); it != _emitters.end(); )
+    {
+        if (it->system->getParent() == nullptr)
+        {
+            it->system->release();
+            it = _emitters.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    if (_emitters.empty())
+        return;
+
+    // the world transforms are cached before the simulation: computing them changes the nodes
+    for (auto& emitter : _emitters)
+    {
+        emitter.particleCount = emitter.system->getParticleCount();
+        if (emitter.system->getPositionType() == ParticleSystem::PositionType::FREE)
+            emitter.system->getNodeToWorldTransform();
+    }
+
+    // the emitters only write to their own particles and quads
+    JobSystem::getInstance()->parallelFor(_emitters.size(), 1, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            _emitters[i].system->simulate(_emitters[i].dt);
+        }
+    });
+
+    // finishing an emitter can remove it from the scene
+    const size_t count = _emitters.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        QueuedEmitter emitter = _emitters[i];
+        emitter.system->finishUpdate(emitter.particleCount);
+        emitter.system->release();
+    }
+    _emitters.erase(_emitters.begin(), _emitters.begin() + count);
+}
+
+NS_CC_END
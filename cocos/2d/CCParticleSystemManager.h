@@ -0,0 +1,103 @@
+/****************************************************************************
+Copyright (c) 2017 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __CCPARTICLESYSTEMMANAGER_H__
+#define __CCPARTICLESYSTEMMANAGER_H__
+
+#include <vector>
+
+#include "platform/CCPlatformMacros.h"
+
+NS_CC_BEGIN
+
+class ParticleSystem;
+
+/**
+ * @addtogroup _2d
+ * @{
+ */
+
+/**
+ * @class ParticleSystemManager
+ * @brief Updates the particle systems of a frame together, on the JobSystem workers.
+ *
+ * When the parallel update is enabled, ParticleSystem::update() only emits the new particles,
+ * and queues the emitter here. Once all the nodes are updated, the manager:
+ * - simulates all the queued emitters in parallel, and fills their quads,
+ * - then, on the cocos thread, disables the batch node quads of the dead particles,
+ *   removes the finished emitters from their parent (setAutoRemoveOnFinish()), and uploads the VBOs.
+ *
+ * Disabled by default.
+ * @since v3.17
+ * @js NA
+ * @lua NA
+ */
+class CC_DLL ParticleSystemManager
+{
+public:
+    /** Returns the shared particle system manager. */
+    static ParticleSystemManager* getInstance();
+
+    /** Destroys the shared particle system manager. */
+    static void destroyInstance();
+
+    /** Enables or disables the parallel update of the particle systems.
+     * When disabled, the emitters queued for the current frame are updated at once.
+     */
+    void setParallelUpdateEnabled(bool enabled);
+
+    /** Whether the particle systems are updated in parallel. */
+    bool isParallelUpdateEnabled() const { return _isParallelUpdate; }
+
+    /** Queues the simulation of an emitter for this frame, called by ParticleSystem::update(). */
+    void addEmitter(ParticleSystem* system, float dt);
+
+    /** Simulates the queued emitters. Scheduled once per frame, after the node updates. */
+    void update(float dt);
+
+CC_CONSTRUCTOR_ACCESS:
+    ParticleSystemManager();
+    ~ParticleSystemManager();
+
+protected:
+    struct QueuedEmitter
+    {
+        ParticleSystem* system;
+        float dt;
+        // the particle count before the simulation, to find the dead particles
+        int particleCount;
+    };
+
+    std::vector<QueuedEmitter> _emitters;
+    bool _isParallelUpdate;
+
+    static ParticleSystemManager* s_sharedParticleSystemManager;
+};
+
+// end of _2d group
+/// @}
+
+NS_CC_END
+
+#endif // __CCPARTICLESYSTEMMANAGER_H__
@@ -42,6 +42,7 @@ THE SOFTWARE.
 #include "base/CCEventListenerCustom.h"
 #include "base/CCEventDispatcher.h"
 #include "base/ccUTF8.h"
+#include "math/MathUtil.h"
 
 NS_CC_BEGIN
 
@@ -328,42 +329,71 @@ void ParticleSystemQuad::updateParticleQuads()
         startQuad = &(_quads[0]);
     }
     
+    Vec3 p1;
+    Mat4 worldToNodeTM;
     if( _positionType == PositionType::FREE )
     {
-        Vec3 p1(currentPosition.x, currentPosition.y, 0);
-        Mat4 worldToNodeTM = getWorldToNodeTransform();
+        p1.set(currentPosition.x, currentPosition.y, 0);
+        worldToNodeTM = getWorldToNodeTransform();
         worldToNodeTM.transformPoint(&p1);
+    }
+
+    // the quads of large emitters are filled on several threads
+    forEachParticleRange([&](size_t begin, size_t end) {
+        fillParticleQuads(startQuad, currentPosition, pos, p1, worldToNodeTM, (int)begin, (int)end);
+    });
+}
+
+void ParticleSystemQuad::fillParticleQuads(V3F_C4B_T2F_Quad* startQuad, const Vec2& currentPosition, const Vec2& pos,
+                                           const Vec3& p1, const Mat4& worldToNodeTM, int begin, int end)
+{
+    const int count = end - begin;
+
+    if( _positionType == PositionType::FREE )
+    {
         Vec3 p2;
         Vec2 newPos;
-        float* startX = _particleData.startPosX;
-        float* startY = _particleData.startPosY;
-        float* x = _particleData.posx;
-        float* y = _particleData.posy;
-        float* s = _particleData.size;
-        float* r = _particleData.rotation;
-        V3F_C4B_T2F_Quad* quadStart = startQuad;
-        for (int i = 0 ; i < _particleCount; ++i, ++startX, ++startY, ++x, ++y, ++quadStart, ++s, ++r)
+        float* startX = _particleData.startPosX + begin;
+        float* startY = _particleData.startPosY + begin;
+        float* x = _particleData.posx + begin;
+        float* y = _particleData.posy + begin;
+        float* s = _particleData.size + begin;
+        float* r = _particleData.rotation + begin;
+        V3F_C4B_T2F_Quad* quadStart = startQuad + begin;
+
+        // the start positions are transformed by chunks, with the batched kernel
+        static const int TRANSFORM_CHUNK_SIZE = 128;
+        Vec3 startPos[TRANSFORM_CHUNK_SIZE];
+        for (int chunkStart = 0; chunkStart < count; chunkStart += TRANSFORM_CHUNK_SIZE)
         {
-            p2.set(*startX, *startY, 0);
-            worldToNodeTM.transformPoint(&p2);
-            newPos.set(*x,*y);
-            p2 = p1 - p2;
-            newPos.x -= p2.x - pos.x;
-            newPos.y -= p2.y - pos.y;
-            updatePosWithParticle(quadStart, newPos, *s, *r);
+            const int chunkSize = std::min(TRANSFORM_CHUNK_SIZE, count - chunkStart);
+            for (int j = 0; j < chunkSize; ++j)
+            {
+                startPos[j].set(startX[j], startY[j], 0);
+            }
+            MathUtil::transformVertices(worldToNodeTM.m, startPos, chunkSize, sizeof(Vec3));
+
+            for (int j = 0; j < chunkSize; ++j, ++startX, ++startY, ++x, ++y, ++quadStart, ++s, ++r)
+            {
+                newPos.set(*x,*y);
+                p2 = p1 - startPos[j];
+                newPos.x -= p2.x - pos.x;
+                newPos.y -= p2.y - pos.y;
+                updatePosWithParticle(quadStart, newPos, *s, *r);
+            }
         }
     }
     else if( _positionType == PositionType::RELATIVE )
     {
         Vec2 newPos;
-        float* startX = _particleData.startPosX;
-        float* startY = _particleData.startPosY;
-        float* x = _particleData.posx;
-        float* y = _particleData.posy;
-        float* s = _particleData.size;
-        float* r = _particleData.rotation;
-        V3F_C4B_T2F_Quad* quadStart = startQuad;
-        for (int i = 0 ; i < _particleCount; ++i, ++startX, ++startY, ++x, ++y, ++quadStart, ++s, ++r)
+        float* startX = _particleData.startPosX + begin;
+        float* startY = _particleData.startPosY + begin;
+        float* x = _particleData.posx + begin;
+        float* y = _particleData.posy + begin;
+        float* s = _particleData.size + begin;
+        float* r = _particleData.rotation + begin;
+        V3F_C4B_T2F_Quad* quadStart = startQuad + begin;
+        for (int i = 0 ; i < count; ++i, ++startX, ++startY, ++x, ++y, ++quadStart, ++s, ++r)
         {
             newPos.set(*x, *y);
             newPos.x = *x - (currentPosition.x - *startX);
@@ -375,14 +405,12 @@ void ParticleSystemQuad::updateParticleQuads()
     else
     {
         Vec2 newPos;
-        float* startX = _particleData.startPosX;
-        float* startY = _particleData.startPosY;
-        float* x = _particleData.posx;
-        float* y = _particleData.posy;
-        float* s = _particleData.size;
-        float* r = _particleData.rotation;
-        V3F_C4B_T2F_Quad* quadStart = startQuad;
-        for (int i = 0 ; i < _particleCount; ++i, ++startX, ++startY, ++x, ++y, ++quadStart, ++s, ++r)
+        float* x = _particleData.posx + begin;
+        float* y = _particleData.posy + begin;
+        float* s = _particleData.size + begin;
+        float* r = _particleData.rotation + begin;
+        V3F_C4B_T2F_Quad* quadStart = startQuad + begin;
+        for (int i = 0 ; i < count; ++i, ++x, ++y, ++quadStart, ++s, ++r)
         {
             newPos.set(*x + pos.x, *y + pos.y);
             updatePosWithParticle(quadStart, newPos, *s, *r);
@@ -392,13 +420,13 @@ void ParticleSystemQuad::updateParticleQuads()
     //set color
     if(_opacityModifyRGB)
     {
-        V3F_C4B_T2F_Quad* quad = startQuad;
-        float* r = _particleData.colorR;
-        float* g = _particleData.colorG;
-        float* b = _particleData.colorB;
-        float* a = _particleData.colorA;
+        V3F_C4B_T2F_Quad* quad = startQuad + begin;
+        float* r = _particleData.colorR + begin;
+        float* g = _particleData.colorG + begin;
+        float* b = _particleData.colorB + begin;
+        float* a = _particleData.colorA + begin;
         
-        for (int i = 0; i < _particleCount; ++i,++quad,++r,++g,++b,++a)
+        for (int i = 0; i < count; ++i,++quad,++r,++g,++b,++a)
         {
             GLubyte colorR = *r * *a * 255;
             GLubyte colorG = *g * *a * 255;
@@ -412,13 +440,13 @@ void ParticleSystemQuad::updateParticleQuads()
     }
     else
     {
-        V3F_C4B_T2F_Quad* quad = startQuad;
-        float* r = _particleData.colorR;
-        float* g = _particleData.colorG;
-        float* b = _particleData.colorB;
-        float* a = _particleData.colorA;
+        V3F_C4B_T2F_Quad* quad = startQuad + begin;
+        float* r = _particleData.colorR + begin;
+        float* g = _particleData.colorG + begin;
+        float* b = _particleData.colorB + begin;
+        float* a = _particleData.colorA + begin;
         
-        for (int i = 0; i < _particleCount; ++i,++quad,++r,++g,++b,++a)
+        for (int i = 0; i < count; ++i,++quad,++r,++g,++b,++a)
         {
             GLubyte colorR = *r * 255;
             GLubyte colorG = *g * 255;
@@ -178,6 +178,10 @@ protected:
     void setupVBO();
     bool allocMemory();
 
+    /** Fills the quads of the particles in [begin, end), called by updateParticleQuads() */
+    void fillParticleQuads(V3F_C4B_T2F_Quad* startQuad, const Vec2& currentPosition, const Vec2& pos,
+                           const Vec3& p1, const Mat4& worldToNodeTM, int begin, int end);
+
     V3F_C4B_T2F_Quad    *_quads;        // quads to be rendered
     GLushort            *_indices;      // indices
     GLuint              _VAOname;
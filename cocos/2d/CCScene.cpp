@@ -66,6 +66,7 @@ Scene::Scene()
     setAnchorPoint(Vec2(0.5f, 0.5f));
     
     _cameraOrderDirty = true;
+    _isParallelTransformUpdate = false;
     
     //create default camera
     _defaultCamera = Camera::create();
@@ -195,6 +196,9 @@ void Scene::render(Renderer* renderer, const Mat4* eyeTransforms, const Mat4* ey
     Camera* defaultCamera = nullptr;
     const auto& transform = getNodeToParentTransform();
 
+    if (_isParallelTransformUpdate)
+        updateTransforms(transform);
+
     for (const auto& camera : getCameras())
     {
         if (!camera->isVisible())
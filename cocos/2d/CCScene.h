@@ -124,6 +124,18 @@ public:
 
     /** override function */
     virtual void removeAllChildren() override;
+
+    /** Enable/Disable computing the node transforms in parallel before the scene is visited.
+     * It pays off with thousands of nodes. Disabled by default.
+     * @see Node::updateTransforms()
+     * @since v3.17
+     */
+    void setParallelTransformUpdateEnabled(bool enabled) { _isParallelTransformUpdate = enabled; }
+
+    /** Whether or not the node transforms are computed in parallel before the scene is visited.
+     * @since v3.17
+     */
+    bool isParallelTransformUpdateEnabled() const { return _isParallelTransformUpdate; }
     
 CC_CONSTRUCTOR_ACCESS:
     Scene();
@@ -147,6 +159,7 @@ protected:
     std::vector<Camera*> _cameras; //weak ref to Camera
     Camera*              _defaultCamera; //weak ref, default camera created by scene, _cameras[0], Caution that the default camera can not be added to _cameras before onEnter is called
     bool                 _cameraOrderDirty; // order is dirty, need sort
+    bool                 _isParallelTransformUpdate;
     EventListenerCustom*       _event;
 
     std::vector<BaseLight *> _lights;
@@ -404,6 +404,7 @@ void Sprite::setTexture(Texture2D *texture)
         CC_SAFE_RELEASE(_texture);
         _texture = texture;
         updateBlendFunc();
+        markSubtreeDirty();
     }
 }
 
@@ -431,6 +432,9 @@ void Sprite::setTextureRect(const Rect& rect, bool rotated, const Size& untrimme
 
 void Sprite::updatePoly()
 {
+    // the vertices might be reallocated
+    markSubtreeDirty();
+
     // There are 3 cases:
     //
     // A) a non 9-sliced, non stretched
@@ -1434,6 +1438,7 @@ void Sprite::setFlippedX(bool flippedX)
     {
         _flippedX = flippedX;
         flipX();
+        markSubtreeDirty();
     }
 }
 
@@ -1448,6 +1453,7 @@ void Sprite::setFlippedY(bool flippedY)
     {
         _flippedY = flippedY;
         flipY();
+        markSubtreeDirty();
     }
 }
 
@@ -1731,6 +1737,7 @@ void Sprite::setPolygonInfo(const PolygonInfo& info)
 {
     _polyInfo = info;
     _renderMode = RenderMode::POLYGON;
+    markSubtreeDirty();
 }
 
 NS_CC_END
@@ -135,6 +135,177 @@ void SpriteFrameCache::initializePolygonInfo(const Size &textureSize,
     info.setRect(Rect(0, 0, spriteSize.width, spriteSize.height));
 }
 
+namespace {
+
+// Reads a frame entry of a plist loaded as a ValueMap, geometry is stored as strings
+class FrameDictReader
+{
+public:
+    explicit FrameDictReader(const ValueMap& dict) : _dict(dict) {}
+
+    bool has(const char* key) const { return _dict.find(key) != _dict.end(); }
+    int getInt(const char* key) const { return get(key).asInt(); }
+    float getFloat(const char* key) const { return get(key).asFloat(); }
+    bool getBool(const char* key) const { return get(key).asBool(); }
+    std::string getString(const char* key) const { return get(key).asString(); }
+    Vec2 getPoint(const char* key) const { return PointFromString(get(key).asString()); }
+    Size getSize(const char* key) const { return SizeFromString(get(key).asString()); }
+    Rect getRect(const char* key) const { return RectFromString(get(key).asString()); }
+
+    std::vector<std::string> getStrings(const char* key) const
+    {
+        std::vector<std::string> strings;
+        const Value& value = get(key);
+        if (value.getType() == Value::Type::VECTOR)
+        {
+            for (const auto& item : value.asValueVector())
+                strings.push_back(item.asString());
+        }
+        return strings;
+    }
+
+private:
+    const Value& get(const char* key) const
+    {
+        auto iter = _dict.find(key);
+        return iter != _dict.end() ? iter->second : Value::Null;
+    }
+
+    const ValueMap& _dict;
+};
+
+// Reads a frame entry of a compiled plist in place, geometry is already parsed
+class FrameBinaryReader
+{
+public:
+    explicit FrameBinaryReader(const ValueBinary::Item& item) : _item(item) {}
+
+    bool has(const char* key) const { return !_item.find(key).isNull(); }
+    int getInt(const char* key) const { return _item.find(key).asInt(); }
+    float getFloat(const char* key) const { return _item.find(key).asFloat(); }
+    bool getBool(const char* key) const { return _item.find(key).asBool(); }
+    std::string getString(const char* key) const { return _item.find(key).asString(); }
+    Vec2 getPoint(const char* key) const { return _item.find(key).asVec2(); }
+    Size getSize(const char* key) const { return _item.find(key).asSize(); }
+    Rect getRect(const char* key) const { return _item.find(key).asRect(); }
+
+    std::vector<std::string> getStrings(const char* key) const
+    {
+        std::vector<std::string> strings;
+        ValueBinary::Item items = _item.find(key);
+        const uint32_t count = items.size();
+        for (uint32_t i = 0; i < count; ++i)
+            strings.push_back(items.at(i).asString());
+        return strings;
+    }
+
+private:
+    ValueBinary::Item _item;
+};
+
+}
+
+template <typename FrameReader>
+SpriteFrame* SpriteFrameCache::createSpriteFrame(const std::string& spriteFrameName, const FrameReader& frameReader,
+                                                 int format, Texture2D* texture, const Size& textureSize)
+{
+    SpriteFrame* spriteFrame = nullptr;
+    if(format == 0) 
+    {
+        float x = frameReader.getFloat("x");
+        float y = frameReader.getFloat("y");
+        float w = frameReader.getFloat("width");
+        float h = frameReader.getFloat("height");
+        float ox = frameReader.getFloat("offsetX");
+        float oy = frameReader.getFloat("offsetY");
+        int ow = frameReader.getInt("originalWidth");
+        int oh = frameReader.getInt("originalHeight");
+        // check ow/oh
+        if(!ow || !oh)
+        {
+            CCLOGWARN("cocos2d: WARNING: originalWidth/Height not found on the SpriteFrame. AnchorPoint won't work as expected. Regenerate the .plist");
+        }
+        // abs ow/oh
+        ow = std::abs(ow);
+        oh = std::abs(oh);
+        // create frame
+        spriteFrame = SpriteFrame::createWithTexture(texture,
+                                                     Rect(x, y, w, h),
+                                                     false,
+                                                     Vec2(ox, oy),
+                                                     Size((float)ow, (float)oh)
+                                                     );
+    } 
+    else if(format == 1 || format == 2) 
+    {
+        Rect frame = frameReader.getRect("frame");
+        bool rotated = false;
+
+        // rotation
+        if (format == 2)
+        {
+            rotated = frameReader.getBool("rotated");
+        }
+
+        Vec2 offset = frameReader.getPoint("offset");
+        Size sourceSize = frameReader.getSize("sourceSize");
+
+        // create frame
+        spriteFrame = SpriteFrame::createWithTexture(texture,
+                                                     frame,
+                                                     rotated,
+                                                     offset,
+                                                     sourceSize
+                                                     );
+    } 
+    else if (format == 3)
+    {
+        // get values
+        Size spriteSize = frameReader.getSize("spriteSize");
+        Vec2 spriteOffset = frameReader.getPoint("spriteOffset");
+        Size spriteSourceSize = frameReader.getSize("spriteSourceSize");
+        Rect textureRect = frameReader.getRect("textureRect");
+        bool textureRotated = frameReader.getBool("textureRotated");
+
+        // get aliases
+        for (const auto& oneAlias : frameReader.getStrings("aliases")) {
+            if (_spriteFramesAliases.find(oneAlias) != _spriteFramesAliases.end())
+            {
+                CCLOGWARN("cocos2d: WARNING: an alias with name %s already exists", oneAlias.c_str());
+            }
+
+            _spriteFramesAliases[oneAlias] = Value(spriteFrameName);
+        }
+
+        // create frame
+        spriteFrame = SpriteFrame::createWithTexture(texture,
+                                                     Rect(textureRect.origin.x, textureRect.origin.y, spriteSize.width, spriteSize.height),
+                                                     textureRotated,
+                                                     spriteOffset,
+                                                     spriteSourceSize);
+
+        if(frameReader.has("vertices"))
+        {
+            std::vector<int> vertices;
+            parseIntegerList(frameReader.getString("vertices"), vertices);
+            std::vector<int> verticesUV;
+            parseIntegerList(frameReader.getString("verticesUV"), verticesUV);
+            std::vector<int> indices;
+            parseIntegerList(frameReader.getString("triangles"), indices);
+
+            PolygonInfo info;
+            initializePolygonInfo(textureSize, spriteSourceSize, vertices, verticesUV, indices, info);
+            spriteFrame->setPolygonInfo(info);
+        }
+        if (frameReader.has("anchor"))
+        {
+            spriteFrame->setAnchorPoint(frameReader.getPoint("anchor"));
+        }
+    }
+
+    return spriteFrame;
+}
+
 void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dictionary, Texture2D* texture)
 {
     /*
@@ -176,7 +347,7 @@ void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dictionary, Textu
     NinePatchImageParser parser;
     for (auto& iter : framesDict)
     {
-        ValueMap& frameDict = iter.second.asValueMap();
+        const ValueMap& frameDict = iter.second.asValueMap();
         std::string spriteFrameName = iter.first;
         SpriteFrame* spriteFrame = _spriteFrames.at(spriteFrameName);
         if (spriteFrame)
@@ -184,101 +355,7 @@ void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dictionary, Textu
             continue;
         }
         
-        if(format == 0) 
-        {
-            float x = frameDict["x"].asFloat();
-            float y = frameDict["y"].asFloat();
-            float w = frameDict["width"].asFloat();
-            float h = frameDict["height"].asFloat();
-            float ox = frameDict["offsetX"].asFloat();
-            float oy = frameDict["offsetY"].asFloat();
-            int ow = frameDict["originalWidth"].asInt();
-            int oh = frameDict["originalHeight"].asInt();
-            // check ow/oh
-            if(!ow || !oh)
-            {
-                CCLOGWARN("cocos2d: WARNING: originalWidth/Height not found on the SpriteFrame. AnchorPoint won't work as expected. Regenerate the .plist");
-            }
-            // abs ow/oh
-            ow = std::abs(ow);
-            oh = std::abs(oh);
-            // create frame
-            spriteFrame = SpriteFrame::createWithTexture(texture,
-                                                         Rect(x, y, w, h),
-                                                         false,
-                                                         Vec2(ox, oy),
-                                                         Size((float)ow, (float)oh)
-                                                         );
-        } 
-        else if(format == 1 || format == 2) 
-        {
-            Rect frame = RectFromString(frameDict["frame"].asString());
-            bool rotated = false;
-
-            // rotation
-            if (format == 2)
-            {
-                rotated = frameDict["rotated"].asBool();
-            }
-
-            Vec2 offset = PointFromString(frameDict["offset"].asString());
-            Size sourceSize = SizeFromString(frameDict["sourceSize"].asString());
-
-            // create frame
-            spriteFrame = SpriteFrame::createWithTexture(texture,
-                                                         frame,
-                                                         rotated,
-                                                         offset,
-                                                         sourceSize
-                                                         );
-        } 
-        else if (format == 3)
-        {
-            // get values
-            Size spriteSize = SizeFromString(frameDict["spriteSize"].asString());
-            Vec2 spriteOffset = PointFromString(frameDict["spriteOffset"].asString());
-            Size spriteSourceSize = SizeFromString(frameDict["spriteSourceSize"].asString());
-            Rect textureRect = RectFromString(frameDict["textureRect"].asString());
-            bool textureRotated = frameDict["textureRotated"].asBool();
-
-            // get aliases
-            ValueVector& aliases = frameDict["aliases"].asValueVector();
-
-            for(const auto &value : aliases) {
-                std::string oneAlias = value.asString();
-                if (_spriteFramesAliases.find(oneAlias) != _spriteFramesAliases.end())
-                {
-                    CCLOGWARN("cocos2d: WARNING: an alias with name %s already exists", oneAlias.c_str());
-                }
-
-                _spriteFramesAliases[oneAlias] = Value(spriteFrameName);
-            }
-
-            // create frame
-            spriteFrame = SpriteFrame::createWithTexture(texture,
-                                                         Rect(textureRect.origin.x, textureRect.origin.y, spriteSize.width, spriteSize.height),
-                                                         textureRotated,
-                                                         spriteOffset,
-                                                         spriteSourceSize);
-
-            if(frameDict.find("vertices") != frameDict.end())
-            {
-                std::vector<int> vertices;
-                parseIntegerList(frameDict["vertices"].asString(), vertices);
-                std::vector<int> verticesUV;
-                parseIntegerList(frameDict["verticesUV"].asString(), verticesUV);
-                std::vector<int> indices;
-                parseIntegerList(frameDict["triangles"].asString(), indices);
-
-                PolygonInfo info;
-                initializePolygonInfo(textureSize, spriteSourceSize, vertices, verticesUV, indices, info);
-                spriteFrame->setPolygonInfo(info);
-            }
-            if (frameDict.find("anchor") != frameDict.end())
-            {
-                spriteFrame->setAnchorPoint(PointFromString(frameDict["anchor"].asString()));
-            }
-        }
+        spriteFrame = createSpriteFrame(spriteFrameName, FrameDictReader(frameDict), format, texture, textureSize);
 
         bool flag = NinePatchImageParser::isNinePatchImage(spriteFrameName);
         if(flag)
@@ -296,18 +373,8 @@ void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dictionary, Textu
     CC_SAFE_DELETE(image);
 }
 
-void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dict, const std::string &texturePath)
+static Texture2D* addTextureWithPixelFormat(const std::string& texturePath, const std::string& pixelFormatName)
 {
-    std::string pixelFormatName;
-    if (dict.find("metadata") != dict.end())
-    {
-        ValueMap& metadataDict = dict.at("metadata").asValueMap();
-        if (metadataDict.find("pixelFormat") != metadataDict.end())
-        {
-            pixelFormatName = metadataDict.at("pixelFormat").asString();
-        }
-    }
-    
     Texture2D *texture = nullptr;
     static std::unordered_map<std::string, Texture2D::PixelFormat> pixelFormats = {
         {"RGBA8888", Texture2D::PixelFormat::RGBA8888},
@@ -337,7 +404,48 @@ void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dict, const std::
     {
         texture = Director::getInstance()->getTextureCache()->addImage(texturePath);
     }
+    return texture;
+}
+
+static std::string texturePathForPlist(const std::string& plist, const std::string& textureFileName)
+{
+    string texturePath(textureFileName);
+
+    if (!texturePath.empty())
+    {
+        // build texture path relative to plist file
+        texturePath = FileUtils::getInstance()->fullPathFromRelativeFile(texturePath, plist);
+    }
+    else
+    {
+        // build texture path by replacing file extension
+        texturePath = plist;
+
+        // remove .xxx
+        size_t startPos = texturePath.find_last_of("."); 
+        texturePath = texturePath.erase(startPos);
+
+        // append .png
+        texturePath = texturePath.append(".png");
+
+        CCLOG("cocos2d: SpriteFrameCache: Trying to use file %s as texture", texturePath.c_str());
+    }
+    return texturePath;
+}
+
+void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dict, const std::string &texturePath)
+{
+    std::string pixelFormatName;
+    if (dict.find("metadata") != dict.end())
+    {
+        ValueMap& metadataDict = dict.at("metadata").asValueMap();
+        if (metadataDict.find("pixelFormat") != metadataDict.end())
+        {
+            pixelFormatName = metadataDict.at("pixelFormat").asString();
+        }
+    }
     
+    Texture2D *texture = addTextureWithPixelFormat(texturePath, pixelFormatName);
     if (texture)
     {
         addSpriteFramesWithDictionary(dict, texture);
@@ -348,6 +456,70 @@ void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dict, const std::
     }
 }
 
+void SpriteFrameCache::addSpriteFramesWithBinary(const ValueBinary::Item& root, Texture2D* texture)
+{
+    // Same as addSpriteFramesWithDictionary, reading the compiled records in place
+    ValueBinary::Item framesItem = root.find("frames");
+    if (framesItem.getType() != ValueBinary::Type::MAP)
+        return;
+
+    int format = 0;
+    Size textureSize;
+
+    ValueBinary::Item metadataItem = root.find("metadata");
+    if (metadataItem.isMap())
+    {
+        format = metadataItem.find("format").asInt();
+        textureSize = metadataItem.find("size").asSize();
+    }
+
+    // check the format
+    CCASSERT(format >=0 && format <= 3, "format is not supported for SpriteFrameCache addSpriteFramesWithBinary:textureFilename:");
+
+    auto textureFileName = Director::getInstance()->getTextureCache()->getTextureFilePath(texture);
+    Image* image = nullptr;
+    NinePatchImageParser parser;
+    const uint32_t count = framesItem.size();
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        std::string spriteFrameName(framesItem.keyAt(i));
+        SpriteFrame* spriteFrame = _spriteFrames.at(spriteFrameName);
+        if (spriteFrame)
+        {
+            continue;
+        }
+
+        spriteFrame = createSpriteFrame(spriteFrameName, FrameBinaryReader(framesItem.valueAt(i)), format, texture, textureSize);
+
+        bool flag = NinePatchImageParser::isNinePatchImage(spriteFrameName);
+        if(flag)
+        {
+            if (image == nullptr) {
+                image = new (std::nothrow) Image();
+                image->initWithImageFile(textureFileName);
+            }
+            parser.setSpriteFrameInfo(image, spriteFrame->getRectInPixels(), spriteFrame->isRotated());
+            texture->addSpriteFrameCapInset(spriteFrame, parser.parseCapInset());
+        }
+        // add sprite frame
+        _spriteFrames.insert(spriteFrameName, spriteFrame);
+    }
+    CC_SAFE_DELETE(image);
+}
+
+void SpriteFrameCache::addSpriteFramesWithBinary(const ValueBinary::Item& root, const std::string &texturePath)
+{
+    Texture2D *texture = addTextureWithPixelFormat(texturePath, root.find("metadata").find("pixelFormat").asString());
+    if (texture)
+    {
+        addSpriteFramesWithBinary(root, texture);
+    }
+    else
+    {
+        CCLOG("cocos2d: SpriteFrameCache: Couldn't load texture");
+    }
+}
+
 void SpriteFrameCache::addSpriteFramesWithFile(const std::string& plist, Texture2D *texture)
 {
     if (_loadedFileNames->find(plist) != _loadedFileNames->end())
@@ -356,9 +528,16 @@ void SpriteFrameCache::addSpriteFramesWithFile(const std::string& plist, Texture
     }
     
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(plist);
-    ValueMap dict = FileUtils::getInstance()->getValueMapFromFile(fullPath);
-
-    addSpriteFramesWithDictionary(dict, texture);
+    ValueMap dict;
+    Data binary = FileUtils::getInstance()->getValueMapBinaryFromFile(fullPath, &dict);
+    if (!binary.isNull())
+    {
+        addSpriteFramesWithBinary(ValueBinary::getRoot(binary.getBytes(), binary.getSize()), texture);
+    }
+    else
+    {
+        addSpriteFramesWithDictionary(dict, texture);
+    }
     _loadedFileNames->insert(plist);
 }
 
@@ -377,8 +556,16 @@ void SpriteFrameCache::addSpriteFramesWithFile(const std::string& plist, const s
     }
     
     const std::string fullPath = FileUtils::getInstance()->fullPathForFilename(plist);
-    ValueMap dict = FileUtils::getInstance()->getValueMapFromFile(fullPath);
-    addSpriteFramesWithDictionary(dict, textureFileName);
+    ValueMap dict;
+    Data binary = FileUtils::getInstance()->getValueMapBinaryFromFile(fullPath, &dict);
+    if (!binary.isNull())
+    {
+        addSpriteFramesWithBinary(ValueBinary::getRoot(binary.getBytes(), binary.getSize()), textureFileName);
+    }
+    else
+    {
+        addSpriteFramesWithDictionary(dict, textureFileName);
+    }
     _loadedFileNames->insert(plist);
 }
 
@@ -396,37 +583,28 @@ void SpriteFrameCache::addSpriteFramesWithFile(const std::string& plist)
 
     if (_loadedFileNames->find(plist) == _loadedFileNames->end())
     {
-        ValueMap dict = FileUtils::getInstance()->getValueMapFromFile(fullPath);
-
-        string texturePath("");
-
-        if (dict.find("metadata") != dict.end())
+        ValueMap dict;
+        Data binary = FileUtils::getInstance()->getValueMapBinaryFromFile(fullPath, &dict);
+        if (!binary.isNull())
         {
-            ValueMap& metadataDict = dict["metadata"].asValueMap();
+            ValueBinary::Item root = ValueBinary::getRoot(binary.getBytes(), binary.getSize());
             // try to read  texture file name from meta data
-            texturePath = metadataDict["textureFileName"].asString();
-        }
-
-        if (!texturePath.empty())
-        {
-            // build texture path relative to plist file
-            texturePath = FileUtils::getInstance()->fullPathFromRelativeFile(texturePath, plist);
+            std::string texturePath = texturePathForPlist(plist, root.find("metadata").find("textureFileName").asString());
+            addSpriteFramesWithBinary(root, texturePath);
         }
         else
         {
-            // build texture path by replacing file extension
-            texturePath = plist;
+            string textureFileName("");
 
-            // remove .xxx
-            size_t startPos = texturePath.find_last_of("."); 
-            texturePath = texturePath.erase(startPos);
-
-            // append .png
-            texturePath = texturePath.append(".png");
+            if (dict.find("metadata") != dict.end())
+            {
+                ValueMap& metadataDict = dict["metadata"].asValueMap();
+                // try to read  texture file name from meta data
+                textureFileName = metadataDict["textureFileName"].asString();
+            }
 
-            CCLOG("cocos2d: SpriteFrameCache: Trying to use file %s as texture", texturePath.c_str());
+            addSpriteFramesWithDictionary(dict, texturePathForPlist(plist, textureFileName));
         }
-        addSpriteFramesWithDictionary(dict, texturePath);
         _loadedFileNames->insert(plist);
     }
 }
@@ -35,6 +35,7 @@ THE SOFTWARE.
 #include "2d/CCSpriteFrame.h"
 #include "base/CCRef.h"
 #include "base/CCValue.h"
+#include "base/CCValueBinary.h"
 #include "base/CCMap.h"
 
 NS_CC_BEGIN
@@ -250,6 +251,24 @@ protected:
     /*Adds multiple Sprite Frames with a dictionary. The texture will be associated with the created sprite frames.
      */
     void addSpriteFramesWithDictionary(ValueMap& dictionary, const std::string &texturePath);
+
+    /** Adds multiple Sprite Frames from a compiled plist, see ValueBinary. Frame geometry is read
+     * without parsing strings.
+     * @since v3.17
+     */
+    void addSpriteFramesWithBinary(const ValueBinary::Item& root, Texture2D *texture);
+
+    /** Adds multiple Sprite Frames from a compiled plist, see ValueBinary.
+     * @since v3.17
+     */
+    void addSpriteFramesWithBinary(const ValueBinary::Item& root, const std::string &texturePath);
+
+    /** Creates the sprite frame of a frame entry, read from a ValueMap or a compiled plist by FrameReader.
+     * Shared by addSpriteFramesWithDictionary and addSpriteFramesWithBinary.
+     */
+    template <typename FrameReader>
+    SpriteFrame* createSpriteFrame(const std::string& spriteFrameName, const FrameReader& frameReader,
+                                   int format, Texture2D* texture, const Size& textureSize);
     
     /** Removes multiple Sprite Frames from Dictionary.
     * @since v0.99.5
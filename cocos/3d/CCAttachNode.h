@@ -64,6 +64,9 @@ CC_CONSTRUCTOR_ACCESS:
     
 
 protected:
+    // the bone is only updated when the Sprite3D is visited
+    virtual bool isTransformPrecomputable() const override { return false; }
+
     Bone3D* _attachBone;
     mutable Mat4    _transformToParent;
 };
@@ -1080,7 +1080,7 @@ bool Bundle3D::loadBinary(const std::string& path)
     
     // get file data
     _binaryBuffer.clear();
-    _binaryBuffer = FileUtils::getInstance()->getDataFromFile(path);
+    _binaryBuffer = FileUtils::getInstance()->getMappedDataFromFile(path);
     if (_binaryBuffer.isNull())
     {
         clear();
@@ -50,6 +50,8 @@ AsyncTaskPool::AsyncTaskPool()
 
 AsyncTaskPool::~AsyncTaskPool()
 {
+    for (int type = 0; type < (int)TaskType::TASK_MAX_TYPE; ++type)
+        stopTasks((TaskType)type);
 }
 
 NS_CC_END
@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "platform/CCPlatformMacros.h"
 #include "base/CCDirector.h"
 #include "base/CCScheduler.h"
+#include "base/CCJobSystem.h"
 #include <vector>
 #include <queue>
 #include <memory>
@@ -48,6 +49,7 @@ NS_CC_BEGIN
 /**
  * @class AsyncTaskPool
  * @brief This class allows to perform background operations without having to manipulate threads.
+ * The tasks are run by the work-stealing workers of the JobSystem, so tasks of the same type may run concurrently.
  * @js NA
  */
 class CC_DLL AsyncTaskPool
@@ -86,7 +88,7 @@ public:
     /**
      * Enqueue a asynchronous task.
      *
-     * @param type task type is io task, network task or others, each type of task has a thread to deal with it.
+     * @param type task type is io task, network task or others, it is used to stop the tasks with stopTasks().
      * @param callback callback when the task is finished. The callback is called in the main thread instead of task thread.
      * @param callbackParam parameter used by the callback.
      * @param task: task can be lambda function to be performed off thread.
@@ -97,7 +99,7 @@ public:
     /**
     * Enqueue a asynchronous task.
     *
-    * @param type task type is io task, network task or others, each type of task has a thread to deal with it.
+    * @param type task type is io task, network task or others, it is used to stop the tasks with stopTasks().
     * @param task: task can be lambda function to be performed off thread.
     * @lua NA
     */
@@ -108,123 +110,30 @@ CC_CONSTRUCTOR_ACCESS:
     ~AsyncTaskPool();
     
 protected:
-    
-    // thread tasks internally used
-    class ThreadTasks {
-        struct AsyncTaskCallBack
-        {
-            TaskCallBack          callback;
-            void*                 callbackParam;
-        };
-    public:
-        ThreadTasks()
-        : _stop(false)
-        {
-            _thread = std::thread(
-                                  [this]
-                                  {
-                                      for(;;)
-                                      {
-                                          std::function<void()> task;
-                                          AsyncTaskCallBack callback;
-                                          {
-                                              std::unique_lock<std::mutex> lock(this->_queueMutex);
-                                              this->_condition.wait(lock,
-                                                                    [this]{ return this->_stop || !this->_tasks.empty(); });
-                                              if(this->_stop && this->_tasks.empty())
-                                                  return;
-                                              task = std::move(this->_tasks.front());
-                                              callback = std::move(this->_taskCallBacks.front());
-                                              this->_tasks.pop();
-                                              this->_taskCallBacks.pop();
-                                          }
-                                          
-                                          task();
-                                          Director::getInstance()->getScheduler()->performFunctionInCocosThread(std::bind(callback.callback, callback.callbackParam));
-                                      }
-                                  }
-                                  );
-        }
-        ~ThreadTasks()
-        {
-            {
-                std::unique_lock<std::mutex> lock(_queueMutex);
-                _stop = true;
-                
-                while(_tasks.size())
-                    _tasks.pop();
-                while (_taskCallBacks.size())
-                    _taskCallBacks.pop();
-            }
-            _condition.notify_all();
-            _thread.join();
-        }
-        void clear()
-        {
-            std::unique_lock<std::mutex> lock(_queueMutex);
-            while(_tasks.size())
-                _tasks.pop();
-            while (_taskCallBacks.size())
-                _taskCallBacks.pop();
-        }
-
-        void enqueue(TaskCallBack callback, void* callbackParam, std::function<void()> task)
-        {
-            AsyncTaskCallBack taskCallBack;
-            taskCallBack.callback = std::move(callback);
-            taskCallBack.callbackParam = callbackParam;
-
-            {
-                std::unique_lock<std::mutex> lock(_queueMutex);
-                
-                // don't allow enqueueing after stopping the pool
-                if(_stop)
-                {
-                    CC_ASSERT(0 && "already stop");
-                    return;
-                }
-                
-                _tasks.push(std::move(task));
-                _taskCallBacks.push(std::move(taskCallBack));
-            }
-            _condition.notify_one();
-        }
-    private:
-        
-        // need to keep track of thread so we can join them
-        std::thread _thread;
-        // the task queue
-        std::queue< std::function<void()> > _tasks;
-        std::queue<AsyncTaskCallBack> _taskCallBacks;
-        
-        // synchronization
-        std::mutex _queueMutex;
-        std::condition_variable _condition;
-        bool _stop;
-    };
-    
-    //tasks
-    ThreadTasks _threadTasks[int(TaskType::TASK_MAX_TYPE)];
-    
+    // JobSystem tags of the task types, negative tags are reserved for the engine
+    static int getTaskTag(TaskType type) { return -1 - (int)type; }
+
     static AsyncTaskPool* s_asyncTaskPool;
 };
 
 inline void AsyncTaskPool::stopTasks(TaskType type)
 {
-    auto& threadTask = _threadTasks[(int)type];
-    threadTask.clear();
+    JobSystem::getInstance()->cancelTasks(getTaskTag(type));
 }
 
 inline void AsyncTaskPool::enqueue(AsyncTaskPool::TaskType type, TaskCallBack callback, void* callbackParam, std::function<void()> task)
 {
-    auto& threadTask = _threadTasks[(int)type];
-    
-    threadTask.enqueue(std::move(callback), callbackParam, std::move(task));
+    std::function<void()> completion;
+    if (callback)
+        completion = std::bind(std::move(callback), callbackParam);
+
+    JobSystem::getInstance()->enqueue(std::move(task), std::move(completion), JobSystem::Priority::NORMAL,
+                                      std::vector<JobSystem::TaskID>(), getTaskTag(type));
 }
 
 inline void AsyncTaskPool::enqueue(AsyncTaskPool::TaskType type, std::function<void()> task)
 {
-    enqueue(type, [](void*) {}, nullptr, std::move(task));
+    enqueue(type, nullptr, nullptr, std::move(task));
 }
 
 NS_CC_END
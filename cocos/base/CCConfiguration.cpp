@@ -52,6 +52,11 @@ Configuration::Configuration()
 , _supportsOESDepth24(false)
 , _supportsOESPackedDepthStencil(false)
 , _supportsOESMapBuffer(false)
+, _supportsMapBufferRange(false)
+, _supportsFenceSync(false)
+, _supportsBufferStorage(false)
+, _supportsProgramBinary(false)
+, _supportsElementIndexUint(false)
 , _maxSamplesAllowed(0)
 , _maxTextureUnits(0)
 , _glExtensions(nullptr)
@@ -167,6 +172,38 @@ void Configuration::gatherGPUInfo()
     _supportsOESPackedDepthStencil = checkForGLExtension("GL_OES_packed_depth_stencil");
     _valueDict["gl.supports_OES_packed_depth_stencil"] = Value(_supportsOESPackedDepthStencil);
 
+#ifdef CC_PLATFORM_PC
+    _supportsMapBufferRange = checkForGLExtension("GL_ARB_map_buffer_range");
+    _supportsFenceSync = checkForGLExtension("GL_ARB_sync");
+    _supportsBufferStorage = checkForGLExtension("GL_ARB_buffer_storage");
+#endif
+    _valueDict["gl.supports_map_buffer_range"] = Value(_supportsMapBufferRange);
+    _valueDict["gl.supports_fence_sync"] = Value(_supportsFenceSync);
+    _valueDict["gl.supports_buffer_storage"] = Value(_supportsBufferStorage);
+
+#if CC_USE_GL_PROGRAM_BINARY_CACHE
+#ifdef CC_PLATFORM_PC
+    _supportsProgramBinary = checkForGLExtension("GL_ARB_get_program_binary");
+#else
+    _supportsProgramBinary = checkForGLExtension("GL_OES_get_program_binary") && glGetProgramBinary && glProgramBinary;
+#endif
+    if (_supportsProgramBinary)
+    {
+        // some drivers expose the extension without any binary format
+        GLint formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        _supportsProgramBinary = formats > 0;
+    }
+#endif
+    _valueDict["gl.supports_program_binary"] = Value(_supportsProgramBinary);
+
+#ifdef CC_PLATFORM_PC
+    _supportsElementIndexUint = true;
+#else
+    _supportsElementIndexUint = checkForGLExtension("GL_OES_element_index_uint");
+#endif
+    _valueDict["gl.supports_element_index_uint"] = Value(_supportsElementIndexUint);
+
 
     CHECK_GL_ERROR_DEBUG();
 }
@@ -294,6 +331,31 @@ bool Configuration::supportsMapBuffer() const
 #endif
 }
 
+bool Configuration::supportsMapBufferRange() const
+{
+    return _supportsMapBufferRange;
+}
+
+bool Configuration::supportsFenceSync() const
+{
+    return _supportsFenceSync;
+}
+
+bool Configuration::supportsBufferStorage() const
+{
+    return _supportsBufferStorage;
+}
+
+bool Configuration::supportsProgramBinary() const
+{
+    return _supportsProgramBinary;
+}
+
+bool Configuration::supportsElementIndexUint() const
+{
+    return _supportsElementIndexUint;
+}
+
 bool Configuration::supportsOESDepth24() const
 {
     return _supportsOESDepth24;
@@ -170,6 +170,48 @@ public:
      */
     bool supportsMapBuffer() const;
 
+    /** Whether or not glMapBufferRange() is supported.
+     *
+     * @return Whether or not `glMapBufferRange()` is supported.
+     * @since v3.17
+     */
+    bool supportsMapBufferRange() const;
+
+    /** Whether or not fence sync objects (glFenceSync / glClientWaitSync) are supported.
+     *
+     * @return Whether or not fence sync objects are supported.
+     * @since v3.17
+     */
+    bool supportsFenceSync() const;
+
+    /** Whether or not immutable buffer storage (glBufferStorage) is supported.
+     * It is needed to keep a buffer persistently mapped.
+     *
+     * @return Whether or not `glBufferStorage()` is supported.
+     * @since v3.17
+     */
+    bool supportsBufferStorage() const;
+
+    /** Whether or not linked programs can be saved and loaded back (glGetProgramBinary / glProgramBinary).
+     *
+     * It checks for `GL_ARB_get_program_binary` on desktop, `GL_OES_get_program_binary` on Android,
+     * and that the driver has at least one binary format.
+     *
+     * @return Whether or not program binaries are supported.
+     * @since v3.17
+     */
+    bool supportsProgramBinary() const;
+
+    /** Whether or not 32 bits indices (GL_UNSIGNED_INT) can be used by glDrawElements().
+     *
+     * On Desktop it returns `true`.
+     * On Mobile it checks for the extension `GL_OES_element_index_uint`
+     *
+     * @return Whether or not 32 bits indices are supported.
+     * @since v3.17
+     */
+    bool supportsElementIndexUint() const;
+
     
     /** Max support directional light in shader, for Sprite3D.
      *
@@ -260,6 +302,11 @@ protected:
     bool            _supportsOESMapBuffer;
     bool            _supportsOESDepth24;
     bool            _supportsOESPackedDepthStencil;
+    bool            _supportsMapBufferRange;
+    bool            _supportsFenceSync;
+    bool            _supportsBufferStorage;
+    bool            _supportsProgramBinary;
+    bool            _supportsElementIndexUint;
     
     GLint           _maxSamplesAllowed;
     GLint           _maxTextureUnits;
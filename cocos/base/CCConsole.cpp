@@ -68,6 +68,9 @@
 #include "base/base64.h"
 #include "base/ccUtils.h"
 #include "base/allocator/CCAllocatorDiagnostics.h"
+#if CC_ENABLE_SCRIPT_BINDING
+#include "base/CCScriptSupport.h"
+#endif
 NS_CC_BEGIN
 
 extern const char* cocos2dVersion(void);
@@ -410,6 +413,7 @@ Console::Console()
     createCommandExit();
     createCommandFileUtils();
     createCommandFps();
+    createCommandGC();
     createCommandHelp();
     createCommandProjection();
     createCommandResolution();
@@ -965,6 +969,12 @@ void Console::createCommandFps()
     addSubCommand("fps", {"off", "Hide the FPS on the bottom-left corner.", CC_CALLBACK_2(Console::commandFpsSubCommandOnOff, this)});
 }
 
+void Console::createCommandGC()
+{
+    addCommand({"gc", "Print the script engine garbage collector stats. Args: [-h | help | ]",
+        CC_CALLBACK_2(Console::commandGC, this)});
+}
+
 void Console::createCommandHelp()
 {
     addCommand({"help", "Print this message. Args: [ ]", CC_CALLBACK_2(Console::commandHelp, this)});
@@ -1209,6 +1219,27 @@ void Console::commandResolutionSubCommandEmpty(int fd, const std::string& /*args
               );
 }
 
+void Console::commandGC(int fd, const std::string& /*args*/)
+{
+    Scheduler *sched = Director::getInstance()->getScheduler();
+    sched->performFunctionInCocosThread( [=](){
+#if CC_ENABLE_SCRIPT_BINDING
+        ScriptEngineProtocol::GarbageCollectorStats stats;
+        ScriptEngineProtocol* engine = ScriptEngineManager::getInstance()->getScriptEngine();
+        if (engine && engine->getGarbageCollectorStats(&stats))
+        {
+            Console::Utility::mydprintf(fd, "GC time: %.3f ms/frame\nHeap: %lu KB\nCycles: %u\n",
+                                        stats.frameTime * 1000, (unsigned long)(stats.heapSize / 1024), stats.cycles);
+        }
+        else
+#endif
+        {
+            Console::Utility::mydprintf(fd, "No script engine garbage collector\n");
+        }
+        Console::Utility::sendPrompt(fd);
+    });
+}
+
 void Console::commandSceneGraph(int fd, const std::string& /*args*/)
 {
     Scheduler *sched = Director::getInstance()->getScheduler();
@@ -1483,7 +1514,7 @@ void Console::printFileUtils(int fd)
     Console::Utility::mydprintf(fd, "%s\n", fu->getWritablePath().c_str());
     
     Console::Utility::mydprintf(fd, "\nFull Path Cache:\n");
-    auto& cache = fu->getFullPathCache();
+    auto cache = fu->getFullPathCache();
     for( const auto &item : cache) {
         Console::Utility::mydprintf(fd, "%s -> %s\n", item.first.c_str(), item.second.c_str());
     }
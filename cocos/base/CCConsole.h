@@ -203,6 +203,7 @@ protected:
     void createCommandExit();
     void createCommandFileUtils();
     void createCommandFps();
+    void createCommandGC();
     void createCommandHelp();
     void createCommandProjection();
     void createCommandResolution();
@@ -227,6 +228,7 @@ protected:
     void commandFileUtilsSubCommandFlush(int fd, const std::string& args);
     void commandFps(int fd, const std::string& args);
     void commandFpsSubCommandOnOff(int fd, const std::string& args);
+    void commandGC(int fd, const std::string& args);
     void commandHelp(int fd, const std::string& args);
     void commandProjection(int fd, const std::string& args);
     void commandProjectionSubCommand2d(int fd, const std::string& args);
@@ -50,7 +50,10 @@ _bytes(nullptr),
 _size(0)
 {
     CCLOGINFO("In the copy constructor of Data.");
-    copy(other._bytes, other._size);
+    if (other._mapping)
+        fastSetMapped(other._bytes, other._size, other._mapping);
+    else
+        copy(other._bytes, other._size);
 }
 
 Data::~Data()
@@ -62,7 +65,10 @@ Data::~Data()
 Data& Data::operator= (const Data& other)
 {
     CCLOGINFO("In the copy assignment of Data.");
-    copy(other._bytes, other._size);
+    if (other._mapping)
+        fastSetMapped(other._bytes, other._size, other._mapping);
+    else
+        copy(other._bytes, other._size);
     return *this;
 }
 
@@ -79,6 +85,7 @@ void Data::move(Data& other)
     
     _bytes = other._bytes;
     _size = other._size;
+    _mapping = std::move(other._mapping);
 
     other._bytes = nullptr;
     other._size = 0;
@@ -113,19 +120,50 @@ void Data::copy(const unsigned char* bytes, const ssize_t size)
 
 void Data::fastSet(unsigned char* bytes, const ssize_t size)
 {
+    _mapping.reset();
     _bytes = bytes;
     _size = size;
 }
 
+void Data::fastSetMapped(unsigned char* bytes, const ssize_t size, std::shared_ptr<void> mapping)
+{
+    if (!_mapping)
+        free(_bytes);
+    _bytes = bytes;
+    _size = size;
+    // releases the previous mapping, if any, once the new one is referenced
+    _mapping = std::move(mapping);
+}
+
+bool Data::isMapped() const
+{
+    return _mapping != nullptr;
+}
+
 void Data::clear()
 {
-    free(_bytes);
+    if (_mapping)
+        _mapping.reset();
+    else
+        free(_bytes);
     _bytes = nullptr;
     _size = 0;
 }
 
 unsigned char* Data::takeBuffer(ssize_t* size)
 {
+    if (_mapping)
+    {
+        // the caller frees the buffer, so it can't be the mapping
+        auto buffer = (unsigned char*)malloc(_size);
+        if (buffer)
+            memcpy(buffer, _bytes, _size);
+        if (size)
+            *size = buffer ? getSize() : 0;
+        clear();
+        return buffer;
+    }
+
     auto buffer = getBytes();
     if (size)
         *size = getSize();
@@ -29,6 +29,7 @@
 #include "platform/CCPlatformMacros.h"
 #include <stdint.h> // for ssize_t on android
 #include <string>   // for ssize_t on linux
+#include <memory>
 #include "platform/CCStdC.h" // for ssize_t on window
 
 /**
@@ -108,6 +109,21 @@ public:
      */
     void fastSet(unsigned char* bytes, const ssize_t size);
 
+    /** Sets the buffer to a read-only memory mapping, see FileUtils::getMappedDataFromFile.
+     *  @param bytes The first mapped byte.
+     *  @param mapping Owns the mapping, its deleter releases the mapping.
+     *  @note The bytes must not be modified. Copies of the Data share the mapping instead of
+     *        copying the bytes; the mapping is released with the last Data using it.
+     *  @since v3.17
+     */
+    void fastSetMapped(unsigned char* bytes, const ssize_t size, std::shared_ptr<void> mapping);
+
+    /**
+     * Check whether the bytes are a read-only memory mapping.
+     * @since v3.17
+     */
+    bool isMapped() const;
+
     /**
      * Clears data, free buffer and reset data size.
      */
@@ -138,7 +154,7 @@ public:
      * @endcode
      *
      * @param size Will fill with the data buffer size in bytes, if you do not care buffer size, pass nullptr.
-     * @return the internal data buffer, free it after use.
+     * @return the internal data buffer, free it after use. A mapped Data returns a copy of its bytes.
      */
     unsigned char* takeBuffer(ssize_t* size);
 private:
@@ -147,6 +163,8 @@ private:
 private:
     unsigned char* _bytes;
     ssize_t _size;
+    // set when _bytes is a memory mapping instead of a malloc'ed buffer
+    std::shared_ptr<void> _mapping;
 };
 
 
@@ -39,6 +39,7 @@ THE SOFTWARE.
 #include "2d/CCFontFNT.h"
 #include "2d/CCFontAtlasCache.h"
 #include "2d/CCAnimationCache.h"
+#include "2d/CCParticleSystemManager.h"
 #include "2d/CCTransition.h"
 #include "2d/CCFontFreeType.h"
 #include "2d/CCLabelAtlas.h"
@@ -60,6 +61,7 @@ THE SOFTWARE.
 #include "base/CCAutoreleasePool.h"
 #include "base/CCConfiguration.h"
 #include "base/CCAsyncTaskPool.h"
+#include "base/CCJobSystem.h"
 #include "platform/CCApplication.h"
 
 #if CC_ENABLE_SCRIPT_BINDING
@@ -134,7 +136,7 @@ bool Director::init(void)
     // FPS
     _accumDt = 0.0f;
     _frameRate = 0.0f;
-    _FPSLabel = _drawnBatchesLabel = _drawnVerticesLabel = nullptr;
+    _FPSLabel = _drawnBatchesLabel = _drawnVerticesLabel = _scriptGCLabel = nullptr;
     _totalFrames = 0;
     _lastUpdate = std::chrono::steady_clock::now();
     
@@ -207,6 +209,7 @@ Director::~Director(void)
     CC_SAFE_RELEASE(_FPSLabel);
     CC_SAFE_RELEASE(_drawnVerticesLabel);
     CC_SAFE_RELEASE(_drawnBatchesLabel);
+    CC_SAFE_RELEASE(_scriptGCLabel);
 
     CC_SAFE_RELEASE(_runningScene);
     CC_SAFE_RELEASE(_notificationNode);
@@ -268,6 +271,14 @@ void Director::setDefaultValues(void)
     // PVR v2 has alpha premultiplied ?
     bool pvr_alpha_premultiplied = conf->getValue("cocos2d.x.texture.pvrv2_has_alpha_premultiplied", Value(false)).asBool();
     Image::setPVRImagesHavePremultipliedAlpha(pvr_alpha_premultiplied);
+
+    // Compile plist files to the writable path on first load
+    bool valuemap_binary_cache = conf->getValue("cocos2d.x.valuemap_binary_cache", Value(false)).asBool();
+    FileUtils::getInstance()->setValueMapBinaryCacheEnabled(valuemap_binary_cache);
+
+    // Lookups of missing files remembered by FileUtils
+    int miss_cache_size = conf->getValue("cocos2d.x.fileutils.miss_cache_size", Value(0)).asInt();
+    FileUtils::getInstance()->setFullPathMissCacheSize(miss_cache_size > 0 ? miss_cache_size : 0);
 }
 
 void Director::setGLDefaultValues()
@@ -283,6 +294,8 @@ void Director::setGLDefaultValues()
 // Draw the Scene
 void Director::drawScene()
 {
+    auto frameStart = std::chrono::steady_clock::now();
+
     // calculate "global" dt
     calculateDeltaTime();
     
@@ -351,12 +364,27 @@ void Director::drawScene()
 
     _totalFrames++;
 
+#if CC_ENABLE_SCRIPT_BINDING
+    // measured before the swap, which may block until the vertical sync
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - frameStart).count() / 1000000.0f;
+#endif
+
     // swap buffers
     if (_openGLView)
     {
         _openGLView->swapBuffers();
     }
 
+#if CC_ENABLE_SCRIPT_BINDING
+    // let the script engine collect garbage in the time left in this frame,
+    // once the frame is presented so the collection doesn't delay it
+    ScriptEngineProtocol* engine = ScriptEngineManager::getInstance()->getScriptEngine();
+    if (engine)
+    {
+        engine->garbageCollectStep(_animationInterval - elapsed);
+    }
+#endif
+
     if (_displayStats)
     {
 #if !CC_STRIP_FPS
@@ -1091,6 +1119,7 @@ void Director::reset()
     CC_SAFE_RELEASE_NULL(_FPSLabel);
     CC_SAFE_RELEASE_NULL(_drawnBatchesLabel);
     CC_SAFE_RELEASE_NULL(_drawnVerticesLabel);
+    CC_SAFE_RELEASE_NULL(_scriptGCLabel);
     
     // purge bitmap cache
     FontFNT::purgeCachedData();
@@ -1116,14 +1145,18 @@ void Director::reset()
 #pragma warning (pop)
 #endif
     AnimationCache::destroyInstance();
+    ParticleSystemManager::destroyInstance();
     SpriteFrameCache::destroyInstance();
     GLProgramCache::destroyInstance();
     GLProgramStateCache::destroyInstance();
-    FileUtils::destroyInstance();
-    AsyncTaskPool::destroyInstance();
     
     // cocos2d-x specific data structures
+    // UserDefault is flushed, and the io tasks are stopped and their threads joined,
+    // before FileUtils goes away, because they write through it
     UserDefault::destroyInstance();
+    AsyncTaskPool::destroyInstance();
+    JobSystem::destroyInstance();
+    FileUtils::destroyInstance();
     
     GL::invalidateStateCache();
 
@@ -1283,6 +1316,12 @@ void Director::showStats()
     {
         char buffer[30] = {0};
 
+#if CC_ENABLE_SCRIPT_BINDING
+        ScriptEngineProtocol::GarbageCollectorStats gcStats;
+        ScriptEngineProtocol* engine = ScriptEngineManager::getInstance()->getScriptEngine();
+        bool showGCStats = _scriptGCLabel && engine && engine->getGarbageCollectorStats(&gcStats);
+#endif
+
         // Probably we don't need this anymore since
         // the framerate is using a low-pass filter
         // to make the FPS stable
@@ -1292,6 +1331,14 @@ void Director::showStats()
             _FPSLabel->setString(buffer);
             _accumDt = 0;
             _frames = 0;
+
+#if CC_ENABLE_SCRIPT_BINDING
+            if (showGCStats)
+            {
+                sprintf(buffer, "GC:%5.2fms %6luK", gcStats.frameTime * 1000, (unsigned long)(gcStats.heapSize / 1024));
+                _scriptGCLabel->setString(buffer);
+            }
+#endif
         }
 
         auto currentCalls = (unsigned long)_renderer->getDrawnBatches();
@@ -1309,6 +1356,12 @@ void Director::showStats()
         }
 
         const Mat4& identity = Mat4::IDENTITY;
+#if CC_ENABLE_SCRIPT_BINDING
+        if (showGCStats)
+        {
+            _scriptGCLabel->visit(_renderer, identity, 0);
+        }
+#endif
         _drawnVerticesLabel->visit(_renderer, identity, 0);
         _drawnBatchesLabel->visit(_renderer, identity, 0);
         _FPSLabel->visit(_renderer, identity, 0);
@@ -1338,15 +1391,18 @@ void Director::createStatsLabel()
     std::string fpsString = "00.0";
     std::string drawBatchString = "000";
     std::string drawVerticesString = "00000";
+    std::string scriptGCString = "GC: 0.00ms      0K";
     if (_FPSLabel)
     {
         fpsString = _FPSLabel->getString();
         drawBatchString = _drawnBatchesLabel->getString();
         drawVerticesString = _drawnVerticesLabel->getString();
+        scriptGCString = _scriptGCLabel->getString();
         
         CC_SAFE_RELEASE_NULL(_FPSLabel);
         CC_SAFE_RELEASE_NULL(_drawnBatchesLabel);
         CC_SAFE_RELEASE_NULL(_drawnVerticesLabel);
+        CC_SAFE_RELEASE_NULL(_scriptGCLabel);
         _textureCache->removeTextureForKey("/cc_fps_images");
         FileUtils::getInstance()->purgeCachedEntries();
     }
@@ -1395,10 +1451,17 @@ void Director::createStatsLabel()
     _drawnVerticesLabel->initWithString(drawVerticesString, texture, 12, 32, '.');
     _drawnVerticesLabel->setScale(scaleFactor);
 
+    _scriptGCLabel = LabelAtlas::create();
+    _scriptGCLabel->retain();
+    _scriptGCLabel->setIgnoreContentScaleFactor(true);
+    _scriptGCLabel->initWithString(scriptGCString, texture, 12, 32, '.');
+    _scriptGCLabel->setScale(scaleFactor);
+
 
     Texture2D::setDefaultAlphaPixelFormat(currentFormat);
 
     const int height_spacing = 22 / CC_CONTENT_SCALE_FACTOR();
+    _scriptGCLabel->setPosition(Vec2(0, height_spacing*3) + CC_DIRECTOR_STATS_POSITION);
     _drawnVerticesLabel->setPosition(Vec2(0, height_spacing*2) + CC_DIRECTOR_STATS_POSITION);
     _drawnBatchesLabel->setPosition(Vec2(0, height_spacing*1) + CC_DIRECTOR_STATS_POSITION);
     _FPSLabel->setPosition(Vec2(0, height_spacing*0)+CC_DIRECTOR_STATS_POSITION);
@@ -656,6 +656,7 @@ protected:
     LabelAtlas *_FPSLabel;
     LabelAtlas *_drawnBatchesLabel;
     LabelAtlas *_drawnVerticesLabel;
+    LabelAtlas *_scriptGCLabel;
     
     /** Whether or not the Director is paused */
     bool _paused;
@@ -0,0 +1,408 @@
+/****************************************************************************
+Copyright (c) 2017 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#include "base/CCJobSystem.h"
+#include <algorithm>
+#include "base/CCDirector.h"
+#include "base/CCScheduler.h"
+
+NS_CC_BEGIN
+
+JobSystem* JobSystem::s_jobSystem = nullptr;
+
+struct JobSystem::Task
+{
+    TaskID id;
+    std::function<void()> func;
+    std::function<void()> completion;
+    Priority priority;
+    int tag;
+    std::atomic<bool> cancelled;
+    // guarded by _tasksMutex
+    int pendingDependencies;
+    std::vector<std::shared_ptr<Task>> dependents;
+};
+
+JobSystem* JobSystem::getInstance()
+{
+    if (s_jobSystem == nullptr)
+    {
+        s_jobSystem = new (std::nothrow) JobSystem();
+    }
+    return s_jobSystem;
+}
+
+void JobSystem::destroyInstance()
+{
+    delete s_jobSystem;
+    s_jobSystem = nullptr;
+}
+
+JobSystem::JobSystem(int workerCount)
+: _func(nullptr)
+, _count(0)
+, _chunkSize(0)
+, _chunkCount(0)
+, _nextChunk(0)
+, _generation(0)
+, _activeWorkers(0)
+, _jobThread(std::thread::id())
+, _stop(false)
+, _queuedTasks(0)
+, _nextQueue(0)
+, _lastTaskID(0)
+{
+    if (workerCount < 0)
+    {
+        // hardware_concurrency() may return 0 when it can't tell
+        int cores = (int)std::thread::hardware_concurrency();
+        workerCount = std::max(cores - 1, 1);
+    }
+
+    _queues.reserve(workerCount);
+    for (int i = 0; i < workerCount; ++i)
+    {
+        _queues.push_back(std::unique_ptr<WorkerQueue>(new (std::nothrow) WorkerQueue()));
+    }
+
+    _workers.reserve(workerCount);
+    for (int i = 0; i < workerCount; ++i)
+    {
+        _workers.push_back(std::thread(&JobSystem::workerLoop, this, i));
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _workAvailable.notify_all();
+
+    for (auto& worker : _workers)
+    {
+        worker.join();
+    }
+}
+
+bool JobSystem::isWorkerThread() const
+{
+    return getWorkerIndex() >= 0;
+}
+
+int JobSystem::getWorkerIndex() const
+{
+    auto currentId = std::this_thread::get_id();
+    for (size_t i = 0, count = _workers.size(); i < count; ++i)
+    {
+        if (_workers[i].get_id() == currentId)
+            return (int)i;
+    }
+    return -1;
+}
+
+void JobSystem::parallelFor(size_t count, size_t grainSize, const RangeFunction& func)
+{
+    if (count == 0)
+        return;
+
+    grainSize = std::max(grainSize, (size_t)1);
+    if (_workers.empty() || count < grainSize * 2 || isWorkerThread() || _jobThread.load() == std::this_thread::get_id())
+    {
+        func(0, count);
+        return;
+    }
+
+    std::lock_guard<std::mutex> jobLock(_jobMutex);
+    _jobThread = std::this_thread::get_id();
+
+    // A few chunks per thread, so that uneven items still balance well
+    const size_t threadCount = _workers.size() + 1;
+    const size_t chunkSize = std::max(grainSize, (count + threadCount * 4 - 1) / (threadCount * 4));
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        // a late worker might still be looking at the previous job
+        _workDone.wait(lock, [this]{ return _activeWorkers == 0; });
+
+        _func = &func;
+        _count = count;
+        _chunkSize = chunkSize;
+        _chunkCount = (count + chunkSize - 1) / chunkSize;
+        _nextChunk = 0;
+        ++_generation;
+    }
+    _workAvailable.notify_all();
+
+    runChunks();
+
+    // every chunk is taken, wait for the ones still running on the workers
+    std::unique_lock<std::mutex> lock(_mutex);
+    _workDone.wait(lock, [this]{ return _activeWorkers == 0; });
+    _func = nullptr;
+    _jobThread = std::thread::id();
+}
+
+void JobSystem::runChunks()
+{
+    for (;;)
+    {
+        size_t chunk = _nextChunk.fetch_add(1);
+        if (chunk >= _chunkCount)
+            break;
+
+        size_t begin = chunk * _chunkSize;
+        size_t end = std::min(begin + _chunkSize, _count);
+        (*_func)(begin, end);
+    }
+}
+
+void JobSystem::workerLoop(int workerIndex)
+{
+    unsigned int generation = 0;
+    for (;;)
+    {
+        bool joinJob = false;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _workAvailable.wait(lock, [this, generation]{ return _stop || _generation != generation || _queuedTasks > 0; });
+            // the queued tasks are dropped
+            if (_stop)
+                return;
+            if (_generation != generation)
+            {
+                generation = _generation;
+                ++_activeWorkers;
+                joinJob = true;
+            }
+        }
+
+        // parallelFor() first: the calling thread is waiting for it
+        if (joinJob)
+        {
+            runChunks();
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                --_activeWorkers;
+            }
+            _workDone.notify_all();
+            continue;
+        }
+
+        auto task = takeTask(workerIndex);
+        if (task)
+            runTask(task);
+        else
+            // another worker took it, but didn't update _queuedTasks yet
+            std::this_thread::yield();
+    }
+}
+
+JobSystem::TaskID JobSystem::enqueue(std::function<void()> task, std::function<void()> completion, Priority priority, const std::vector<TaskID>& dependencies, int tag)
+{
+    auto newTask = std::make_shared<Task>();
+    newTask->func = std::move(task);
+    newTask->completion = std::move(completion);
+    newTask->priority = priority;
+    newTask->tag = tag;
+    newTask->cancelled = false;
+    newTask->pendingDependencies = 0;
+
+    TaskID id;
+    bool ready;
+    {
+        std::lock_guard<std::mutex> lock(_tasksMutex);
+        id = ++_lastTaskID;
+        newTask->id = id;
+        _tasks[id] = newTask;
+
+        for (const auto& dependency : dependencies)
+        {
+            auto it = _tasks.find(dependency);
+            if (it != _tasks.end())
+            {
+                it->second->dependents.push_back(newTask);
+                ++newTask->pendingDependencies;
+            }
+        }
+        ready = (newTask->pendingDependencies == 0);
+    }
+
+    // otherwise, the last dependency to finish schedules it
+    if (ready)
+        scheduleTask(newTask);
+
+    return id;
+}
+
+void JobSystem::scheduleTask(const std::shared_ptr<Task>& task)
+{
+    if (_queues.empty())
+    {
+        runTask(task);
+        return;
+    }
+
+    // a worker keeps the tasks it spawns, the others are spread over the queues
+    int queueIndex = getWorkerIndex();
+    if (queueIndex < 0)
+        queueIndex = (int)(_nextQueue++ % _queues.size());
+
+    auto& queue = *_queues[queueIndex];
+    {
+        // counted under the queue lock, so a worker taking the task can't decrement first
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        ++_queuedTasks;
+        queue.tasks[(int)task->priority].push_back(task);
+    }
+
+    {
+        // makes sure a worker checking _queuedTasks is either before it, or waiting
+        std::lock_guard<std::mutex> lock(_mutex);
+    }
+    _workAvailable.notify_one();
+}
+
+std::shared_ptr<JobSystem::Task> JobSystem::takeTask(int workerIndex)
+{
+    const int queueCount = (int)_queues.size();
+    for (int priority = (int)Priority::COUNT - 1; priority >= 0; --priority)
+    {
+        // its own queue first, then steal from the next ones
+        for (int i = 0; i < queueCount; ++i)
+        {
+            auto& queue = *_queues[(workerIndex + i) % queueCount];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            auto& tasks = queue.tasks[priority];
+            if (!tasks.empty())
+            {
+                auto task = std::move(tasks.front());
+                tasks.pop_front();
+                int queuedTasks = --_queuedTasks;
+                CCASSERT(queuedTasks >= 0, "JobSystem: queued task count underflow");
+                (void)queuedTasks;
+                return task;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::runTask(const std::shared_ptr<Task>& task)
+{
+    if (!task->cancelled)
+        task->func();
+
+    std::vector<std::shared_ptr<Task>> dependents;
+    {
+        std::lock_guard<std::mutex> lock(_tasksMutex);
+        _tasks.erase(task->id);
+        dependents.swap(task->dependents);
+        // keep only the ones that are ready
+        dependents.erase(std::remove_if(dependents.begin(), dependents.end(), [](const std::shared_ptr<Task>& dependent) {
+            return --dependent->pendingDependencies > 0;
+        }), dependents.end());
+    }
+
+    for (const auto& dependent : dependents)
+    {
+        scheduleTask(dependent);
+    }
+
+    if (task->completion && !task->cancelled)
+    {
+        Director::getInstance()->getScheduler()->performFunctionInCocosThread(std::move(task->completion));
+    }
+}
+
+void JobSystem::cancelTasks(int tag)
+{
+    // the tasks waiting for their dependencies are skipped once they are ready
+    {
+        std::lock_guard<std::mutex> lock(_tasksMutex);
+        for (const auto& task : _tasks)
+        {
+            if (task.second->tag == tag && task.second->pendingDependencies > 0)
+                task.second->cancelled = true;
+        }
+    }
+
+    // the queued ones are removed now, to release the tasks depending on them
+    std::vector<std::shared_ptr<Task>> cancelled;
+    for (const auto& queue : _queues)
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        for (auto& tasks : queue->tasks)
+        {
+            for (auto it = tasks.begin(); it != tasks.end(); )
+            {
+                if ((*it)->tag == tag)
+                {
+                    cancelled.push_back(std::move(*it));
+                    it = tasks.erase(it);
+                    int queuedTasks = --_queuedTasks;
+                    CCASSERT(queuedTasks >= 0, "JobSystem: queued task count underflow");
+                    (void)queuedTasks;
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+    }
+
+    // only their dependents are released, func and completion are skipped
+    for (const auto& task : cancelled)
+    {
+        task->cancelled = true;
+        runTask(task);
+    }
+}
+
+std::vector<size_t> JobSystem::getQueueDepths() const
+{
+    std::vector<size_t> depths;
+    depths.reserve(_queues.size());
+    for (const auto& queue : _queues)
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        size_t depth = 0;
+        for (const auto& tasks : queue->tasks)
+            depth += tasks.size();
+        depths.push_back(depth);
+    }
+    return depths;
+}
+
+size_t JobSystem::getPendingTaskCount() const
+{
+    std::lock_guard<std::mutex> lock(_tasksMutex);
+    return _tasks.size();
+}
+
+NS_CC_END
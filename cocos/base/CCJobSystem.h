@@ -0,0 +1,210 @@
+/****************************************************************************
+Copyright (c) 2017 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __CC_JOB_SYSTEM_H_
+#define __CC_JOB_SYSTEM_H_
+
+#include "platform/CCPlatformMacros.h"
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+
+/**
+* @addtogroup base
+* @{
+*/
+NS_CC_BEGIN
+
+/**
+ * @class JobSystem
+ * @brief A pool of worker threads shared by the engine, for two kinds of work:
+ *
+ * - parallelFor() splits per-frame work (vertex transforms, particles...) across the cores.
+ *   The call is blocking: the calling thread takes part in the work, and returns once all of it is done.
+ *   So the callbacks can safely capture locals by reference.
+ * - enqueue() runs async tasks (file loading, decoding...), with priorities and dependencies.
+ *   Each worker has its own queue, and idle workers steal the tasks queued on the others.
+ *   The completion callbacks are called on the cocos thread by the Scheduler. AsyncTaskPool is built on them.
+ *
+ * parallelFor() jobs are run before the queued tasks, but a worker busy with a task only joins them once it is done.
+ * @js NA
+ * @lua NA
+ */
+class CC_DLL JobSystem
+{
+public:
+    /** The function run on a range of items: [begin, end). */
+    typedef std::function<void(size_t begin, size_t end)> RangeFunction;
+
+    /** Identifies an async task. 0 is never a valid task. */
+    typedef uint64_t TaskID;
+
+    /** Priority of the async tasks: the queued tasks with the highest priority are started first. */
+    enum class Priority
+    {
+        LOW,
+        NORMAL,
+        HIGH,
+        COUNT,
+    };
+
+    /**
+     * Returns the shared instance of the job system.
+     */
+    static JobSystem* getInstance();
+
+    /**
+     * Destroys the job system, joining its worker threads.
+     */
+    static void destroyInstance();
+
+    /**
+     * Returns the number of worker threads, not counting the thread calling parallelFor().
+     */
+    int getWorkerCount() const { return (int)_workers.size(); }
+
+    /**
+     * Splits [0, count) into chunks of at least `grainSize` items, and runs `func` on them
+     * from the worker threads and the calling thread. Returns once all the chunks are done.
+     *
+     * The work is run inline when there is no worker, when it doesn't fill two chunks,
+     * or when nested in another parallelFor() (from a worker or from the calling thread).
+     *
+     * @param count The number of items.
+     * @param grainSize The minimum number of items per chunk.
+     * @param func The function to run on each chunk. It must be thread safe.
+     */
+    void parallelFor(size_t count, size_t grainSize, const RangeFunction& func);
+
+    /**
+     * Runs `task` on a worker thread, once all its dependencies are done.
+     * Without worker threads, it is run immediately on the calling thread.
+     *
+     * @param task The function to run. It must be thread safe.
+     * @param completion If not null, called on the cocos thread once `task` is done.
+     * @param priority The queued tasks with a higher priority are started first.
+     * @param dependencies The tasks that must be done before this one starts. Unknown ids are ignored,
+     *        they belong to tasks already done.
+     * @param tag Used to cancel the task with cancelTasks(). Negative tags are reserved for the engine.
+     * @return The id of the task, to make other tasks depend on it.
+     */
+    TaskID enqueue(std::function<void()> task, std::function<void()> completion = nullptr,
+                   Priority priority = Priority::NORMAL,
+                   const std::vector<TaskID>& dependencies = std::vector<TaskID>(), int tag = 0);
+
+    /**
+     * Cancels the tasks with this tag that didn't start yet: neither they nor their completion will be called.
+     * The tasks depending on them are run anyway.
+     */
+    void cancelTasks(int tag);
+
+    /**
+     * Returns the number of tasks waiting in the queue of each worker, not counting
+     * the tasks waiting for their dependencies.
+     */
+    std::vector<size_t> getQueueDepths() const;
+
+    /**
+     * Returns the number of tasks enqueued and not done yet, including the ones waiting for their dependencies.
+     */
+    size_t getPendingTaskCount() const;
+
+CC_CONSTRUCTOR_ACCESS:
+    /**
+     * @param workerCount The number of worker threads. A negative value uses one less than the number of cores,
+     *        with at least one worker so that the async tasks never run on the cocos thread.
+     */
+    explicit JobSystem(int workerCount = -1);
+    ~JobSystem();
+
+protected:
+    struct Task;
+    // the queued tasks of a worker, by priority
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<std::shared_ptr<Task>> tasks[(int)Priority::COUNT];
+    };
+
+    void workerLoop(int workerIndex);
+    // Runs chunks of the current job until there are none left
+    void runChunks();
+    bool isWorkerThread() const;
+    // -1 when not called from a worker
+    int getWorkerIndex() const;
+
+    // Queues a task whose dependencies are done
+    void scheduleTask(const std::shared_ptr<Task>& task);
+    // Pops a task from the queue of the worker, or steals one from the others
+    std::shared_ptr<Task> takeTask(int workerIndex);
+    void runTask(const std::shared_ptr<Task>& task);
+
+    std::vector<std::thread> _workers;
+
+    // the current parallelFor job
+    const RangeFunction* _func;
+    size_t _count;
+    size_t _chunkSize;
+    size_t _chunkCount;
+    std::atomic<size_t> _nextChunk;
+    // incremented for each job, so the workers know when there is new work
+    unsigned int _generation;
+    // workers currently running chunks. The job fields can't change until it drops to 0.
+    int _activeWorkers;
+
+    // only one parallelFor at a time
+    std::mutex _jobMutex;
+    // the thread running the current parallelFor, to run the nested ones inline
+    std::atomic<std::thread::id> _jobThread;
+
+    // synchronization with the workers
+    std::mutex _mutex;
+    std::condition_variable _workAvailable;
+    std::condition_variable _workDone;
+    bool _stop;
+
+    // async tasks
+    std::vector<std::unique_ptr<WorkerQueue>> _queues;
+    // signed, so an underflow is caught by the asserts instead of wrapping
+    std::atomic<int> _queuedTasks;
+    std::atomic<unsigned int> _nextQueue;
+    // the tasks not done yet, by id, and the ones waiting for them
+    mutable std::mutex _tasksMutex;
+    std::unordered_map<TaskID, std::shared_ptr<Task>> _tasks;
+    TaskID _lastTaskID;
+
+    static JobSystem* s_jobSystem;
+};
+
+NS_CC_END
+// end group
+/// @}
+#endif //__CC_JOB_SYSTEM_H_
@@ -0,0 +1,371 @@
+/****************************************************************************
+Copyright (c) 2017 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "base/CCPackFile.h"
+#include "base/ZipUtils.h"
+#include "base/ccMacros.h"
+#include "platform/CCFileUtils.h"
+#include "xxhash.h"
+
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+NS_CC_BEGIN
+
+/*
+ Pack file layout, little endian:
+
+ Header (32 bytes):
+    char     magic[4]      "CCPK"
+    uint32_t version       1
+    uint32_t entryCount
+    uint32_t reserved
+    uint64_t indexOffset
+    uint64_t namesOffset
+
+ Entry data, each entry starts at a multiple of 16 bytes.
+
+ Names: the entry names, each followed by a '\0'.
+
+ Index: entryCount records sorted by hash, then name:
+    uint32_t hash          XXH32 of the name
+    uint32_t nameOffset    from namesOffset
+    uint64_t offset
+    uint64_t size
+ */
+
+namespace
+{
+    const char PACK_MAGIC[4] = { 'C', 'C', 'P', 'K' };
+    const uint32_t PACK_VERSION = 1;
+    const uint64_t PACK_ALIGNMENT = 16;
+
+    struct PackHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t reserved;
+        uint64_t indexOffset;
+        uint64_t namesOffset;
+    };
+
+    struct PackEntry
+    {
+        uint32_t hash;
+        uint32_t nameOffset;
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    static_assert(sizeof(PackHeader) == 32, "PackHeader must be 32 bytes");
+    static_assert(sizeof(PackEntry) == 24, "PackEntry must be 24 bytes");
+
+    PackEntry readEntry(const unsigned char* index, uint32_t i)
+    {
+        PackEntry entry;
+        memcpy(&entry, index + i * sizeof(PackEntry), sizeof(PackEntry));
+        return entry;
+    }
+
+    bool writePadding(FILE* fp, uint64_t* offset, uint64_t alignment)
+    {
+        static const char zeros[PACK_ALIGNMENT] = { 0 };
+        size_t padding = (size_t)((alignment - *offset % alignment) % alignment);
+        *offset += padding;
+        return padding == 0 || fwrite(zeros, padding, 1, fp) == 1;
+    }
+}
+
+PackFile* PackFile::create(const std::string& fullPath)
+{
+    auto data = std::make_shared<Data>(FileUtils::getInstance()->getMappedDataFromFile(fullPath));
+    if (data->getSize() < 4)
+    {
+        CCLOG("PackFile: can't read %s", fullPath.c_str());
+        return nullptr;
+    }
+
+    PackFile* packFile = new (std::nothrow) PackFile();
+    if (!packFile)
+        return nullptr;
+    packFile->_path = fullPath;
+    packFile->_data = data;
+
+    bool ret = false;
+    const unsigned char* bytes = data->getBytes();
+    if (memcmp(bytes, PACK_MAGIC, sizeof(PACK_MAGIC)) == 0)
+    {
+        ret = packFile->initWithPackData();
+    }
+    else if (bytes[0] == 'P' && bytes[1] == 'K')
+    {
+        // the zip file reads from the buffer, which the pack file keeps alive
+        packFile->_zipFile = ZipFile::createWithBuffer(bytes, (unsigned long)data->getSize());
+        ret = packFile->_zipFile != nullptr;
+    }
+
+    if (!ret)
+    {
+        CCLOG("PackFile: %s is not a valid pack or zip file", fullPath.c_str());
+        delete packFile;
+        return nullptr;
+    }
+    return packFile;
+}
+
+PackFile::PackFile()
+: _index(nullptr)
+, _entryCount(0)
+, _names(nullptr)
+, _namesSize(0)
+, _zipFile(nullptr)
+{
+}
+
+PackFile::~PackFile()
+{
+    CC_SAFE_DELETE(_zipFile);
+}
+
+bool PackFile::initWithPackData()
+{
+    const unsigned char* bytes = _data->getBytes();
+    const uint64_t size = (uint64_t)_data->getSize();
+    if (size < sizeof(PackHeader))
+        return false;
+
+    PackHeader header;
+    memcpy(&header, bytes, sizeof(header));
+    if (header.version != PACK_VERSION
+        || header.namesOffset > header.indexOffset
+        || header.indexOffset > size
+        || (size - header.indexOffset) / sizeof(PackEntry) < header.entryCount)
+    {
+        return false;
+    }
+
+    _index = bytes + header.indexOffset;
+    _entryCount = header.entryCount;
+    _names = (const char*)bytes + header.namesOffset;
+    _namesSize = header.indexOffset - header.namesOffset;
+
+    // validate once so lookups don't have to
+    for (uint32_t i = 0; i < _entryCount; ++i)
+    {
+        PackEntry entry = readEntry(_index, i);
+        if (entry.nameOffset >= _namesSize
+            || !memchr(_names + entry.nameOffset, '\0', (size_t)(_namesSize - entry.nameOffset))
+            || entry.offset > size || entry.size > size - entry.offset)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+const unsigned char* PackFile::findEntry(const std::string& name, uint64_t* size) const
+{
+    const uint32_t hash = XXH32(name.c_str(), name.length(), 0);
+
+    // lower bound of the hash
+    uint32_t first = 0;
+    uint32_t count = _entryCount;
+    while (count > 0)
+    {
+        uint32_t step = count / 2;
+        if (readEntry(_index, first + step).hash < hash)
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+
+    for (uint32_t i = first; i < _entryCount; ++i)
+    {
+        PackEntry entry = readEntry(_index, i);
+        if (entry.hash != hash)
+            break;
+        if (name == _names + entry.nameOffset)
+        {
+            *size = entry.size;
+            return _data->getBytes() + entry.offset;
+        }
+    }
+    return nullptr;
+}
+
+bool PackFile::fileExists(const std::string& name) const
+{
+    if (_zipFile)
+    {
+        return _zipFile->fileExists(name);
+    }
+
+    uint64_t size;
+    return findEntry(name, &size) != nullptr;
+}
+
+bool PackFile::getFileData(const std::string& name, ResizableBuffer* buffer) const
+{
+    if (_zipFile)
+    {
+        std::lock_guard<std::mutex> lock(_zipMutex);
+        return _zipFile->getFileData(name, buffer);
+    }
+
+    uint64_t size;
+    const unsigned char* bytes = findEntry(name, &size);
+    if (!bytes)
+        return false;
+
+    buffer->resize((size_t)size);
+    if (size > 0)
+        memcpy(buffer->buffer(), bytes, (size_t)size);
+    return true;
+}
+
+Data PackFile::getMappedFileData(const std::string& name) const
+{
+    Data data;
+    // a view into a heap-read archive, like an apk asset, could be written through and
+    // corrupt later loads of the entry, so those entries are copied as well
+    if (_zipFile || !_data->isMapped())
+    {
+        ResizableBufferAdapter<Data> buffer(&data);
+        getFileData(name, &buffer);
+        return data;
+    }
+
+    uint64_t size;
+    const unsigned char* bytes = findEntry(name, &size);
+    if (bytes && size > 0)
+    {
+        // the entry keeps the whole archive alive
+        data.fastSetMapped(const_cast<unsigned char*>(bytes), (ssize_t)size, _data);
+    }
+    return data;
+}
+
+bool PackFile::createFromDirectory(const std::string& directory, const std::string& fullPath)
+{
+    auto fileUtils = FileUtils::getInstance();
+    std::string root = fileUtils->fullPathForFilename(directory);
+    if (root.empty() || !fileUtils->isDirectoryExist(root))
+    {
+        CCLOG("PackFile: %s is not a directory", directory.c_str());
+        return false;
+    }
+    if (root[root.length()-1] != '/')
+        root += '/';
+
+    std::vector<std::string> files;
+    fileUtils->listFilesRecursively(root, &files);
+
+    std::vector<std::string> names;
+    for (const auto& file : files)
+    {
+        if (file.empty() || file[file.length()-1] == '/' || file.compare(0, root.length() - 1, root, 0, root.length() - 1) != 0)
+            continue;
+        // listed paths are the directory path, maybe followed by a doubled separator, and the name
+        size_t start = root.length() - 1;
+        while (start < file.length() && file[start] == '/')
+            ++start;
+        names.push_back(file.substr(start));
+    }
+    // keep the entries of a directory together
+    std::sort(names.begin(), names.end());
+
+    FILE* fp = fopen(fileUtils->getSuitableFOpen(fullPath).c_str(), "wb");
+    if (!fp)
+    {
+        CCLOG("PackFile: can't write %s", fullPath.c_str());
+        return false;
+    }
+
+    PackHeader header;
+    memset(&header, 0, sizeof(header));
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+    uint64_t offset = sizeof(header);
+
+    std::vector<PackEntry> entries;
+    std::string namesBlob;
+    entries.reserve(names.size());
+    for (const auto& name : names)
+    {
+        Data data;
+        if (fileUtils->getContents(root + name, &data) != FileUtils::Status::OK)
+        {
+            CCLOG("PackFile: can't read %s", (root + name).c_str());
+            ok = false;
+        }
+        ok = ok && writePadding(fp, &offset, PACK_ALIGNMENT);
+
+        PackEntry entry;
+        entry.hash = XXH32(name.c_str(), name.length(), 0);
+        entry.nameOffset = (uint32_t)namesBlob.size();
+        entry.offset = offset;
+        entry.size = (uint64_t)data.getSize();
+        entries.push_back(entry);
+        namesBlob.append(name.c_str(), name.length() + 1);
+
+        if (data.getSize() > 0)
+            ok = ok && fwrite(data.getBytes(), (size_t)data.getSize(), 1, fp) == 1;
+        offset += entry.size;
+    }
+
+    header.namesOffset = offset;
+    ok = ok && (namesBlob.empty() || fwrite(namesBlob.data(), namesBlob.size(), 1, fp) == 1);
+    offset += namesBlob.size();
+    ok = ok && writePadding(fp, &offset, sizeof(uint64_t));
+    header.indexOffset = offset;
+
+    std::sort(entries.begin(), entries.end(), [&namesBlob](const PackEntry& a, const PackEntry& b) {
+        if (a.hash != b.hash)
+            return a.hash < b.hash;
+        return strcmp(namesBlob.c_str() + a.nameOffset, namesBlob.c_str() + b.nameOffset) < 0;
+    });
+    ok = ok && (entries.empty() || fwrite(entries.data(), sizeof(PackEntry), entries.size(), fp) == entries.size());
+
+    memcpy(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC));
+    header.version = PACK_VERSION;
+    header.entryCount = (uint32_t)entries.size();
+    ok = ok && fseek(fp, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, fp) == 1;
+    ok = (fclose(fp) == 0) && ok;
+
+    if (!ok)
+    {
+        CCLOG("PackFile: error writing %s", fullPath.c_str());
+        // don't leave a truncated archive behind
+        fileUtils->removeFile(fullPath);
+    }
+    return ok;
+}
+
+NS_CC_END
@@ -0,0 +1,121 @@
+/****************************************************************************
+Copyright (c) 2017 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __CC_PACK_FILE_H__
+#define __CC_PACK_FILE_H__
+
+#include "platform/CCPlatformMacros.h"
+#include "base/CCData.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/**
+ * @addtogroup base
+ * @{
+ */
+NS_CC_BEGIN
+
+class ResizableBuffer;
+class ZipFile;
+
+/**
+ * @class PackFile
+ * @brief An archive of files which FileUtils can mount as a directory.
+ *
+ * Two formats are read: zip files, and pack files written by createFromDirectory.
+ * A pack file stores its entries uncompressed and 16 byte aligned, followed by an
+ * index sorted by the hash of the entry names, so mounting one only validates
+ * the index, and entries are read in place from the mapped file.
+ *
+ * @see FileUtils::mountPackFile
+ * @since v3.17
+ * @js NA
+ * @lua NA
+ */
+class CC_DLL PackFile
+{
+public:
+    /**
+     * Opens a zip file or a pack file.
+     * The archive is memory mapped when it is on the file system, see FileUtils::getMappedDataFromFile.
+     * @param fullPath The full path of the archive.
+     * @return The archive, or nullptr if it can't be read or has an unknown format.
+     */
+    static PackFile* create(const std::string& fullPath);
+
+    /**
+     * Writes the files under a directory to a pack file.
+     * @param directory The directory, its files are named by their path relative to it.
+     * @param fullPath The full path of the pack file to write.
+     * @return false if a file can't be read or the pack file can't be written, in which case it is removed.
+     */
+    static bool createFromDirectory(const std::string& directory, const std::string& fullPath);
+
+    ~PackFile();
+
+    /** The full path passed to create. */
+    const std::string& getPath() const { return _path; }
+
+    /** Returns true if the archive contains the entry, names use '/' separators. */
+    bool fileExists(const std::string& name) const;
+
+    /** Copies an entry to a buffer. */
+    bool getFileData(const std::string& name, ResizableBuffer* buffer) const;
+
+    /**
+     * Returns an entry of a pack file without copying it when the archive is memory mapped;
+     * the Data then shares the archive's read-only mapping and must not be modified.
+     * Entries of zip files and of archives read to the heap are copied.
+     * Callers which decode their input in place must use getFileData instead.
+     */
+    Data getMappedFileData(const std::string& name) const;
+
+private:
+    PackFile();
+
+    bool initWithPackData();
+    // Returns the bytes of a pack file entry, or nullptr
+    const unsigned char* findEntry(const std::string& name, uint64_t* size) const;
+
+    std::string _path;
+    std::shared_ptr<Data> _data;
+
+    // pack files
+    const unsigned char* _index;
+    uint32_t _entryCount;
+    const char* _names;
+    uint64_t _namesSize;
+
+    // zip files, reading an entry moves the unzip cursor
+    ZipFile* _zipFile;
+    mutable std::mutex _zipMutex;
+};
+
+NS_CC_END
+// end of base group
+/** @} */
+
+#endif /* __CC_PACK_FILE_H__ */
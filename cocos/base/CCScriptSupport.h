@@ -805,6 +805,32 @@ public:
 
     /** Triggers the garbage collector */
     virtual void garbageCollect() {}
+
+    /** Garbage collector stats, see getGarbageCollectorStats().
+     * @since v3.17
+     */
+    struct GarbageCollectorStats
+    {
+        /** Smoothed time spent collecting per frame, in seconds */
+        float frameTime;
+        /** Memory used by the script engine, in bytes */
+        size_t heapSize;
+        /** Number of completed collection cycles */
+        unsigned int cycles;
+    };
+
+    /** Lets the garbage collector use the idle time left in a frame.
+     * Called by the Director once per frame, after the buffers were swapped.
+     * @param budget Seconds left before the next frame is due, 0 or less if the frame ran late.
+     * @since v3.17
+     */
+    virtual void garbageCollectStep(float /*budget*/) {}
+
+    /** Gets the garbage collector stats shown by the Director stats display and the Console.
+     * @return false if the script engine doesn't provide stats.
+     * @since v3.17
+     */
+    virtual bool getGarbageCollectorStats(GarbageCollectorStats* /*stats*/) { return false; }
 };
 
 class Node;
@@ -28,6 +28,10 @@ THE SOFTWARE.
 #include "tinyxml2.h"
 #include "base/base64.h"
 #include "base/ccUtils.h"
+#include "base/CCAsyncTaskPool.h"
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
 
 #if (CC_TARGET_PLATFORM != CC_PLATFORM_IOS && CC_TARGET_PLATFORM != CC_PLATFORM_MAC && CC_TARGET_PLATFORM != CC_PLATFORM_ANDROID)
 
@@ -43,98 +47,185 @@ NS_CC_BEGIN
 /**
  * define the functions here because we don't want to
  * export xmlNodePtr and other types in "CCUserDefault.h"
+ *
+ * The xml file is parsed once into s_values. Setters only change the map and
+ * schedule a write on the io task queue, so a burst of setters is written once.
+ * flush() writes synchronously. The file is written to a temporary file which is
+ * then renamed over UserDefault.xml, so a crash never leaves a truncated file.
  */
 
-static tinyxml2::XMLElement* getXMLNodeForKey(const char* pKey, tinyxml2::XMLElement** rootNode, tinyxml2::XMLDocument **doc)
-{
-    tinyxml2::XMLElement* curNode = nullptr;
+// guards the values and the fields below
+static std::mutex s_valuesMutex;
+static std::unordered_map<std::string, std::string> s_values;
+static bool s_valuesLoaded = false;
+// incremented by every change
+static unsigned int s_valuesVersion = 0;
+static bool s_saveScheduled = false;
 
-    // check the key value
-    if (! pKey)
+// serializes the writers
+static std::mutex s_saveMutex;
+static unsigned int s_savedVersion = 0;
+
+// must be called with s_valuesMutex locked
+static void loadValues()
+{
+    if (s_valuesLoaded)
     {
-        return nullptr;
+        return;
     }
+    s_valuesLoaded = true;
 
-    do 
+    std::string xmlBuffer = FileUtils::getInstance()->getStringFromFile(UserDefault::getXMLFilePath());
+    if (xmlBuffer.empty())
     {
-         tinyxml2::XMLDocument* xmlDoc = new (std::nothrow) tinyxml2::XMLDocument();
-        *doc = xmlDoc;
+        CCLOG("can not read xml file");
+        return;
+    }
 
-        std::string xmlBuffer = FileUtils::getInstance()->getStringFromFile(UserDefault::getInstance()->getXMLFilePath());
+    tinyxml2::XMLDocument xmlDoc;
+    xmlDoc.Parse(xmlBuffer.c_str(), xmlBuffer.size());
 
-        if (xmlBuffer.empty())
+    tinyxml2::XMLElement* rootNode = xmlDoc.RootElement();
+    if (nullptr == rootNode)
+    {
+        CCLOG("read root node error");
+        return;
+    }
+
+    for (auto curNode = rootNode->FirstChildElement(); curNode; curNode = curNode->NextSiblingElement())
+    {
+        // same as the previous lookup: the first node with a key and a value wins
+        if (curNode->FirstChild() && s_values.find(curNode->Value()) == s_values.end())
         {
-            CCLOG("can not read xml file");
-            break;
+            s_values.emplace(curNode->Value(), curNode->FirstChild()->Value());
         }
-        xmlDoc->Parse(xmlBuffer.c_str(), xmlBuffer.size());
+    }
+}
+
+// must be called with s_valuesMutex locked
+static std::string serializeValues()
+{
+    // sort the keys so the file content doesn't depend on the hash order
+    std::vector<const std::pair<const std::string, std::string>*> entries;
+    entries.reserve(s_values.size());
+    for (const auto& entry : s_values)
+    {
+        entries.push_back(&entry);
+    }
+    std::sort(entries.begin(), entries.end(), [](const std::pair<const std::string, std::string>* a,
+                                                 const std::pair<const std::string, std::string>* b) {
+        return a->first < b->first;
+    });
+
+    tinyxml2::XMLPrinter printer;
+    printer.PushHeader(false, true);
+    printer.OpenElement(USERDEFAULT_ROOT_NAME);
+    for (auto entry : entries)
+    {
+        printer.OpenElement(entry->first.c_str());
+        printer.PushText(entry->second.c_str());
+        printer.CloseElement();
+    }
+    printer.CloseElement();
+
+    return std::string(printer.CStr(), printer.CStrSize() - 1);
+}
 
-        // get root node
-        *rootNode = xmlDoc->RootElement();
-        if (nullptr == *rootNode)
+static void saveValues()
+{
+    std::string xml;
+    unsigned int version;
+    {
+        std::lock_guard<std::mutex> lock(s_valuesMutex);
+        s_saveScheduled = false;
+        if (!s_valuesLoaded)
         {
-            CCLOG("read root node error");
-            break;
+            return;
         }
-        // find the node
-        curNode = (*rootNode)->FirstChildElement();
-        while (nullptr != curNode)
+
         {
-            const char* nodeName = curNode->Value();
-            if (!strcmp(nodeName, pKey))
+            std::lock_guard<std::mutex> saveLock(s_saveMutex);
+            if (s_savedVersion == s_valuesVersion)
             {
-                break;
+                return;
             }
-
-            curNode = curNode->NextSiblingElement();
         }
-    } while (0);
 
-    return curNode;
+        xml = serializeValues();
+        version = s_valuesVersion;
+    }
+
+    std::lock_guard<std::mutex> lock(s_saveMutex);
+    // a newer version may have been written while this one was serialized
+    if ((int)(version - s_savedVersion) <= 0)
+    {
+        return;
+    }
+
+    auto fileUtils = FileUtils::getInstance();
+    const std::string& path = UserDefault::getXMLFilePath();
+    std::string tmpPath = path + ".tmp";
+    if (!fileUtils->writeStringToFile(xml, tmpPath) || !fileUtils->renameFile(tmpPath, path))
+    {
+        CCLOG("UserDefault: can not write %s", path.c_str());
+        return;
+    }
+    s_savedVersion = version;
+}
+
+// must be called with s_valuesMutex locked
+static void scheduleSave()
+{
+    ++s_valuesVersion;
+    if (!s_saveScheduled)
+    {
+        s_saveScheduled = true;
+        AsyncTaskPool::getInstance()->enqueue(AsyncTaskPool::TaskType::TASK_IO, &saveValues);
+    }
+}
+
+static bool getValueForKey(const char* pKey, std::string* value)
+{
+    if (! pKey)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(s_valuesMutex);
+    loadValues();
+    auto iter = s_values.find(pKey);
+    if (iter == s_values.end())
+    {
+        return false;
+    }
+    *value = iter->second;
+    return true;
 }
 
 static void setValueForKey(const char* pKey, const char* pValue)
 {
-     tinyxml2::XMLElement* rootNode;
-    tinyxml2::XMLDocument* doc;
-    tinyxml2::XMLElement* node;
     // check the params
     if (! pKey || ! pValue)
     {
         return;
     }
-    // find the node
-    node = getXMLNodeForKey(pKey, &rootNode, &doc);
-    // if node exist, change the content
-    if (node)
+
+    std::lock_guard<std::mutex> lock(s_valuesMutex);
+    loadValues();
+    auto iter = s_values.find(pKey);
+    if (iter != s_values.end())
     {
-        if (node->FirstChild())
-        {
-            node->FirstChild()->SetValue(pValue);
-        }
-        else
+        if (iter->second == pValue)
         {
-            tinyxml2::XMLText* content = doc->NewText(pValue);
-            node->LinkEndChild(content);
+            return;
         }
+        iter->second = pValue;
     }
     else
     {
-        if (rootNode)
-        {
-            tinyxml2::XMLElement* tmpNode = doc->NewElement(pKey);//new tinyxml2::XMLElement(pKey);
-            rootNode->LinkEndChild(tmpNode);
-            tinyxml2::XMLText* content = doc->NewText(pValue);//new tinyxml2::XMLText(pValue);
-            tmpNode->LinkEndChild(content);
-        }    
-    }
-
-    // save file and free doc
-    if (doc)
-    {
-        doc->SaveFile(FileUtils::getInstance()->getSuitableFOpen(UserDefault::getInstance()->getXMLFilePath()).c_str());
-        delete doc;
+        s_values.emplace(pKey, pValue);
     }
+    scheduleSave();
 }
 
 /**
@@ -160,27 +251,13 @@ bool UserDefault::getBoolForKey(const char* pKey)
 
 bool UserDefault::getBoolForKey(const char* pKey, bool defaultValue)
 {
-    const char* value = nullptr;
-    tinyxml2::XMLElement* rootNode;
-    tinyxml2::XMLDocument* doc;
-    tinyxml2::XMLElement* node;
-    node =  getXMLNodeForKey(pKey, &rootNode, &doc);
-    // find the node
-    if (node && node->FirstChild())
+    std::string value;
+    if (getValueForKey(pKey, &value))
     {
-        value = (const char*)(node->FirstChild()->Value());
+        return value == "true";
     }
 
-    bool ret = defaultValue;
-
-    if (value)
-    {
-        ret = (! strcmp(value, "true"));
-    }
-
-    if (doc) delete doc;
-
-    return ret;
+    return defaultValue;
 }
 
 int UserDefault::getIntegerForKey(const char* pKey)
@@ -190,31 +267,13 @@ int UserDefault::getIntegerForKey(const char* pKey)
 
 int UserDefault::getIntegerForKey(const char* pKey, int defaultValue)
 {
-    const char* value = nullptr;
-    tinyxml2::XMLElement* rootNode;
-    tinyxml2::XMLDocument* doc;
-    tinyxml2::XMLElement* node;
-    node =  getXMLNodeForKey(pKey, &rootNode, &doc);
-    // find the node
-    if (node && node->FirstChild())
+    std::string value;
+    if (getValueForKey(pKey, &value))
     {
-        value = (const char*)(node->FirstChild()->Value());
+        return atoi(value.c_str());
     }
 
-    int ret = defaultValue;
-
-    if (value)
-    {
-        ret = atoi(value);
-    }
-
-    if(doc)
-    {
-        delete doc;
-    }
-
-
-    return ret;
+    return defaultValue;
 }
 
 float UserDefault::getFloatForKey(const char* pKey)
@@ -236,27 +295,13 @@ double  UserDefault::getDoubleForKey(const char* pKey)
 
 double UserDefault::getDoubleForKey(const char* pKey, double defaultValue)
 {
-    const char* value = nullptr;
-    tinyxml2::XMLElement* rootNode;
-    tinyxml2::XMLDocument* doc;
-    tinyxml2::XMLElement* node;
-    node =  getXMLNodeForKey(pKey, &rootNode, &doc);
-    // find the node
-    if (node && node->FirstChild())
+    std::string value;
+    if (getValueForKey(pKey, &value))
     {
-        value = (const char*)(node->FirstChild()->Value());
+        return utils::atof(value.c_str());
     }
 
-    double ret = defaultValue;
-
-    if (value)
-    {
-        ret = utils::atof(value);
-    }
-
-    if (doc) delete doc;
-
-    return ret;
+    return defaultValue;
 }
 
 std::string UserDefault::getStringForKey(const char* pKey)
@@ -266,27 +311,13 @@ std::string UserDefault::getStringForKey(const char* pKey)
 
 string UserDefault::getStringForKey(const char* pKey, const std::string & defaultValue)
 {
-    const char* value = nullptr;
-    tinyxml2::XMLElement* rootNode;
-    tinyxml2::XMLDocument* doc;
-    tinyxml2::XMLElement* node;
-    node =  getXMLNodeForKey(pKey, &rootNode, &doc);
-    // find the node
-    if (node && node->FirstChild())
-    {
-        value = (const char*)(node->FirstChild()->Value());
-    }
-
-    string ret = defaultValue;
-
-    if (value)
+    string value;
+    if (getValueForKey(pKey, &value))
     {
-        ret = string(value);
+        return value;
     }
 
-    if (doc) delete doc;
-
-    return ret;
+    return defaultValue;
 }
 
 Data UserDefault::getDataForKey(const char* pKey)
@@ -296,32 +327,21 @@ Data UserDefault::getDataForKey(const char* pKey)
 
 Data UserDefault::getDataForKey(const char* pKey, const Data& defaultValue)
 {
-    const char* encodedData = nullptr;
-    tinyxml2::XMLElement* rootNode;
-    tinyxml2::XMLDocument* doc;
-    tinyxml2::XMLElement* node;
-    node =  getXMLNodeForKey(pKey, &rootNode, &doc);
-    // find the node
-    if (node && node->FirstChild())
-    {
-        encodedData = (const char*)(node->FirstChild()->Value());
-    }
+    std::string encodedData;
     
     Data ret = defaultValue;
     
-    if (encodedData)
+    if (getValueForKey(pKey, &encodedData))
     {
         unsigned char * decodedData = nullptr;
-        int decodedDataLen = base64Decode((unsigned char*)encodedData, (unsigned int)strlen(encodedData), &decodedData);
+        int decodedDataLen = base64Decode((unsigned char*)encodedData.c_str(), (unsigned int)encodedData.size(), &decodedData);
         
         if (decodedData) {
             ret.fastSet(decodedData, decodedDataLen);
         }
     }
     
-    if (doc) delete doc;
-    
-    return ret;    
+    return ret;
 }
 
 
@@ -425,13 +445,18 @@ UserDefault* UserDefault::getInstance()
 
 void UserDefault::destroyInstance()
 {
+    if (_userDefault)
+        _userDefault->flush();
     CC_SAFE_DELETE(_userDefault);
 }
 
 void UserDefault::setDelegate(UserDefault *delegate)
 {
     if (_userDefault)
+    {
+        _userDefault->flush();
         delete _userDefault;
+    }
 
     _userDefault = delegate;
 }
@@ -501,14 +526,11 @@ const string& UserDefault::getXMLFilePath()
 
 void UserDefault::flush()
 {
+    saveValues();
 }
 
 void UserDefault::deleteValueForKey(const char* key)
 {
-    tinyxml2::XMLElement* rootNode;
-    tinyxml2::XMLDocument* doc;
-    tinyxml2::XMLElement* node;
-
     // check the params
     if (!key)
     {
@@ -516,24 +538,13 @@ void UserDefault::deleteValueForKey(const char* key)
         return;
     }
 
-    // find the node
-    node = getXMLNodeForKey(key, &rootNode, &doc);
-
+    std::lock_guard<std::mutex> lock(s_valuesMutex);
+    loadValues();
     // if node not exist, don't need to delete
-    if (!node)
-    {
-        return;
-    }
-
-    // save file and free doc
-    if (doc)
+    if (s_values.erase(key) != 0)
     {
-        doc->DeleteNode(node);
-        doc->SaveFile(FileUtils::getInstance()->getSuitableFOpen(UserDefault::getInstance()->getXMLFilePath()).c_str());
-        delete doc;
+        scheduleSave();
     }
-
-    flush();
 }
 
 NS_CC_END
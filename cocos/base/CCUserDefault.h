@@ -46,6 +46,8 @@ NS_CC_BEGIN
  *
  * @warning: On windows, linux, use XML to store data, which means there are some limitations of
  * the key string, for example, `/` is not valid.
+ * The XML file is read once and kept in memory. Changes are written back in batches on a background
+ * thread, call flush() to write them immediately.
  */
 class CC_DLL UserDefault
 {
@@ -201,6 +203,8 @@ public:
     virtual void setDataForKey(const char* key, const Data& value);
     /**
      * You should invoke this function to save values set by setXXXForKey().
+     * On platforms using the XML file, this writes pending changes synchronously, before
+     * the background write-back would. It is also called by destroyInstance().
      * @js NA
      */
     virtual void flush();
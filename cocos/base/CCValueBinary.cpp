@@ -0,0 +1,740 @@
+/****************************************************************************
+Copyright (c) 2017 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "base/CCValueBinary.h"
+#include "base/CCNS.h"
+#include "base/ccUtils.h"
+#include "base/ccMacros.h"
+
+#include <string.h>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+NS_CC_BEGIN
+
+/*
+ * Layout, all integers are uint32 and all numbers are stored in the byte order of the
+ * machine which compiled the file, so records are read with a plain memcpy. The version
+ * reads differently on a machine with the other byte order, such files are rejected.
+ *
+ *   header  : magic "CCVB", version, sourceSize, sourceHash, stringsOffset, stringsSize, root record
+ *   record  : type, value
+ *   body    : containers, doubles and float lists referenced by records
+ *   strings : null terminated strings, referenced by offset from stringsOffset
+ *
+ * Record values are the value itself for BYTE, INTEGER, UNSIGNED, FLOAT and BOOLEAN,
+ * a string offset for STRING and an absolute offset for everything else:
+ *
+ *   DOUBLE        : 8 bytes
+ *   STRING_FLOATS : stringOffset, count, float[count]
+ *   VECTOR        : count, record[count]
+ *   MAP           : count, { keyStringOffset, record }[count], sorted by key
+ *   INT_KEY_MAP   : count, { key, record }[count], sorted by key
+ */
+namespace
+{
+    const char VALUE_BINARY_MAGIC[4] = { 'C', 'C', 'V', 'B' };
+    const uint32_t VALUE_BINARY_VERSION = 1;
+
+    const uint32_t HEADER_SIZE = 32;
+    const uint32_t OFFSET_VERSION = 4;
+    const uint32_t OFFSET_SOURCE_SIZE = 8;
+    const uint32_t OFFSET_SOURCE_HASH = 12;
+    const uint32_t OFFSET_STRINGS = 16;
+    const uint32_t OFFSET_STRINGS_SIZE = 20;
+    const uint32_t OFFSET_ROOT = 24;
+
+    const uint32_t RECORD_SIZE = 8;
+    const uint32_t MAP_ENTRY_SIZE = 4 + RECORD_SIZE;
+
+    inline uint32_t readU32(const unsigned char* p)
+    {
+        uint32_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    inline void writeU32(unsigned char* p, uint32_t v)
+    {
+        memcpy(p, &v, sizeof(v));
+    }
+
+    inline uint32_t swapU32(uint32_t v)
+    {
+        return (v >> 24) | ((v >> 8) & 0xff00) | ((v << 8) & 0xff0000) | (v << 24);
+    }
+
+    inline void skipSpaces(const char*& p)
+    {
+        while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')
+            ++p;
+    }
+
+    bool parseNumber(const char*& p, float* out)
+    {
+        skipSpaces(p);
+        const char* begin = p;
+        while ((*p >= '0' && *p <= '9') || *p == '.' || *p == '-' || *p == '+' || *p == 'e' || *p == 'E')
+            ++p;
+        if (p == begin)
+            return false;
+
+        // Same conversion as the *FromString functions
+        *out = (float)utils::atof(std::string(begin, p - begin).c_str());
+        skipSpaces(p);
+        return true;
+    }
+
+    bool parsePair(const char*& p, float* out)
+    {
+        skipSpaces(p);
+        if (*p++ != '{')
+            return false;
+        if (!parseNumber(p, &out[0]) || *p++ != ',')
+            return false;
+        if (!parseNumber(p, &out[1]) || *p++ != '}')
+            return false;
+        skipSpaces(p);
+        return true;
+    }
+
+    // Recognizes "{x,y}" and "{{x,y},{w,h}}", returns the number of floats or 0
+    uint32_t parseFloats(const std::string& str, float* out)
+    {
+        if (str.empty() || str[0] != '{')
+            return 0;
+
+        const char* p = str.c_str();
+        uint32_t count = 0;
+
+        const char* inner = p + 1;
+        skipSpaces(inner);
+        if (*inner == '{')
+        {
+            ++p;
+            if (!parsePair(p, out) || *p++ != ',' || !parsePair(p, out + 2) || *p++ != '}')
+                return 0;
+            count = 4;
+        }
+        else
+        {
+            if (!parsePair(p, out))
+                return 0;
+            count = 2;
+        }
+
+        skipSpaces(p);
+        return *p == '\0' ? count : 0;
+    }
+
+    class Writer
+    {
+    public:
+        Writer()
+        : _buffer(HEADER_SIZE, 0)
+        {
+        }
+
+        Data finish(const ValueMap& dict, uint32_t sourceHash, uint32_t sourceSize)
+        {
+            unsigned char root[RECORD_SIZE];
+            writeMap(dict, root);
+
+            uint32_t stringsOffset = (uint32_t)_buffer.size();
+            _buffer.insert(_buffer.end(), _strings.begin(), _strings.end());
+
+            unsigned char* header = _buffer.data();
+            memcpy(header, VALUE_BINARY_MAGIC, sizeof(VALUE_BINARY_MAGIC));
+            writeU32(header + OFFSET_VERSION, VALUE_BINARY_VERSION);
+            writeU32(header + OFFSET_SOURCE_SIZE, sourceSize);
+            writeU32(header + OFFSET_SOURCE_HASH, sourceHash);
+            writeU32(header + OFFSET_STRINGS, stringsOffset);
+            writeU32(header + OFFSET_STRINGS_SIZE, (uint32_t)_strings.size());
+            memcpy(header + OFFSET_ROOT, root, RECORD_SIZE);
+
+            Data ret;
+            ret.copy(_buffer.data(), (ssize_t)_buffer.size());
+            return ret;
+        }
+
+    private:
+        uint32_t addString(const std::string& str)
+        {
+            auto iter = _stringOffsets.find(str);
+            if (iter != _stringOffsets.end())
+                return iter->second;
+
+            uint32_t offset = (uint32_t)_strings.size();
+            _strings.append(str.c_str(), str.size() + 1);
+            _stringOffsets.emplace(str, offset);
+            return offset;
+        }
+
+        uint32_t reserve(uint32_t size)
+        {
+            uint32_t offset = (uint32_t)_buffer.size();
+            _buffer.resize(offset + size, 0);
+            return offset;
+        }
+
+        void setRecord(unsigned char* record, ValueBinary::Type type, uint32_t value)
+        {
+            writeU32(record, (uint32_t)type);
+            writeU32(record + 4, value);
+        }
+
+        void writeValue(const Value& value, unsigned char* record)
+        {
+            switch (value.getType())
+            {
+            case Value::Type::BYTE:
+                setRecord(record, ValueBinary::Type::BYTE, value.asByte());
+                break;
+            case Value::Type::INTEGER:
+                setRecord(record, ValueBinary::Type::INTEGER, (uint32_t)value.asInt());
+                break;
+            case Value::Type::UNSIGNED:
+                setRecord(record, ValueBinary::Type::UNSIGNED, value.asUnsignedInt());
+                break;
+            case Value::Type::FLOAT:
+                {
+                    float f = value.asFloat();
+                    uint32_t bits;
+                    memcpy(&bits, &f, sizeof(bits));
+                    setRecord(record, ValueBinary::Type::FLOAT, bits);
+                }
+                break;
+            case Value::Type::DOUBLE:
+                {
+                    double d = value.asDouble();
+                    uint32_t offset = reserve(sizeof(d));
+                    memcpy(_buffer.data() + offset, &d, sizeof(d));
+                    setRecord(record, ValueBinary::Type::DOUBLE, offset);
+                }
+                break;
+            case Value::Type::BOOLEAN:
+                setRecord(record, ValueBinary::Type::BOOLEAN, value.asBool() ? 1 : 0);
+                break;
+            case Value::Type::STRING:
+                writeString(value.asString(), record);
+                break;
+            case Value::Type::VECTOR:
+                writeVector(value.asValueVector(), record);
+                break;
+            case Value::Type::MAP:
+                writeMap(value.asValueMap(), record);
+                break;
+            case Value::Type::INT_KEY_MAP:
+                writeIntKeyMap(value.asIntKeyMap(), record);
+                break;
+            default:
+                setRecord(record, ValueBinary::Type::NONE, 0);
+                break;
+            }
+        }
+
+        void writeString(const std::string& str, unsigned char* record)
+        {
+            uint32_t stringOffset = addString(str);
+
+            float floats[4];
+            uint32_t count = parseFloats(str, floats);
+            if (count == 0)
+            {
+                setRecord(record, ValueBinary::Type::STRING, stringOffset);
+                return;
+            }
+
+            uint32_t offset = reserve(8 + count * sizeof(float));
+            unsigned char* p = _buffer.data() + offset;
+            writeU32(p, stringOffset);
+            writeU32(p + 4, count);
+            memcpy(p + 8, floats, count * sizeof(float));
+            setRecord(record, ValueBinary::Type::STRING_FLOATS, offset);
+        }
+
+        void writeVector(const ValueVector& vector, unsigned char* record)
+        {
+            // Children first, they may grow the buffer
+            std::vector<unsigned char> records(vector.size() * RECORD_SIZE);
+            for (size_t i = 0; i < vector.size(); ++i)
+                writeValue(vector[i], records.data() + i * RECORD_SIZE);
+
+            uint32_t offset = reserve(4 + (uint32_t)records.size());
+            writeU32(_buffer.data() + offset, (uint32_t)vector.size());
+            if (!records.empty())
+                memcpy(_buffer.data() + offset + 4, records.data(), records.size());
+            setRecord(record, ValueBinary::Type::VECTOR, offset);
+        }
+
+        void writeMap(const ValueMap& map, unsigned char* record)
+        {
+            std::vector<const ValueMap::value_type*> sorted;
+            sorted.reserve(map.size());
+            for (const auto& iter : map)
+                sorted.push_back(&iter);
+            std::sort(sorted.begin(), sorted.end(), [](const ValueMap::value_type* a, const ValueMap::value_type* b) {
+                return strcmp(a->first.c_str(), b->first.c_str()) < 0;
+            });
+
+            std::vector<unsigned char> entries(sorted.size() * MAP_ENTRY_SIZE);
+            for (size_t i = 0; i < sorted.size(); ++i)
+            {
+                unsigned char* entry = entries.data() + i * MAP_ENTRY_SIZE;
+                writeU32(entry, addString(sorted[i]->first));
+                writeValue(sorted[i]->second, entry + 4);
+            }
+
+            uint32_t offset = reserve(4 + (uint32_t)entries.size());
+            writeU32(_buffer.data() + offset, (uint32_t)sorted.size());
+            if (!entries.empty())
+                memcpy(_buffer.data() + offset + 4, entries.data(), entries.size());
+            setRecord(record, ValueBinary::Type::MAP, offset);
+        }
+
+        void writeIntKeyMap(const ValueMapIntKey& map, unsigned char* record)
+        {
+            std::vector<const ValueMapIntKey::value_type*> sorted;
+            sorted.reserve(map.size());
+            for (const auto& iter : map)
+                sorted.push_back(&iter);
+            std::sort(sorted.begin(), sorted.end(), [](const ValueMapIntKey::value_type* a, const ValueMapIntKey::value_type* b) {
+                return a->first < b->first;
+            });
+
+            std::vector<unsigned char> entries(sorted.size() * MAP_ENTRY_SIZE);
+            for (size_t i = 0; i < sorted.size(); ++i)
+            {
+                unsigned char* entry = entries.data() + i * MAP_ENTRY_SIZE;
+                writeU32(entry, (uint32_t)sorted[i]->first);
+                writeValue(sorted[i]->second, entry + 4);
+            }
+
+            uint32_t offset = reserve(4 + (uint32_t)entries.size());
+            writeU32(_buffer.data() + offset, (uint32_t)sorted.size());
+            if (!entries.empty())
+                memcpy(_buffer.data() + offset + 4, entries.data(), entries.size());
+            setRecord(record, ValueBinary::Type::INT_KEY_MAP, offset);
+        }
+
+        std::vector<unsigned char> _buffer;
+        std::string _strings;
+        std::unordered_map<std::string, uint32_t> _stringOffsets;
+    };
+}
+
+// ValueBinary::Item
+
+ValueBinary::Item::Item()
+: _data(nullptr)
+, _size(0)
+, _type(Type::NONE)
+, _value(0)
+{
+}
+
+ValueBinary::Item::Item(const unsigned char* data, uint32_t size, const unsigned char* record)
+: _data(data)
+, _size(size)
+, _type((Type)readU32(record))
+, _value(readU32(record + 4))
+{
+}
+
+const unsigned char* ValueBinary::Item::container(uint32_t entrySize, uint32_t* count) const
+{
+    if ((uint64_t)_value + 4 > _size)
+        return nullptr;
+
+    uint32_t n = readU32(_data + _value);
+    if ((uint64_t)_value + 4 + (uint64_t)n * entrySize > _size)
+        return nullptr;
+
+    *count = n;
+    return _data + _value + 4;
+}
+
+const char* ValueBinary::Item::string(uint32_t offset) const
+{
+    // The table is null terminated, checked by getRoot()
+    uint32_t stringsOffset = readU32(_data + OFFSET_STRINGS);
+    uint32_t stringsSize = readU32(_data + OFFSET_STRINGS_SIZE);
+    if (offset >= stringsSize)
+        return "";
+    return reinterpret_cast<const char*>(_data + stringsOffset + offset);
+}
+
+int ValueBinary::Item::asInt() const
+{
+    switch (_type)
+    {
+    case Type::BYTE:
+    case Type::INTEGER:
+    case Type::UNSIGNED:
+    case Type::BOOLEAN:
+        return (int)_value;
+    case Type::FLOAT:
+    case Type::DOUBLE:
+        return (int)asDouble();
+    case Type::STRING:
+    case Type::STRING_FLOATS:
+        return atoi(asString());
+    default:
+        return 0;
+    }
+}
+
+float ValueBinary::Item::asFloat() const
+{
+    if (_type == Type::FLOAT)
+    {
+        float f;
+        memcpy(&f, &_value, sizeof(f));
+        return f;
+    }
+    return (float)asDouble();
+}
+
+double ValueBinary::Item::asDouble() const
+{
+    switch (_type)
+    {
+    case Type::BYTE:
+    case Type::UNSIGNED:
+    case Type::BOOLEAN:
+        return (double)_value;
+    case Type::INTEGER:
+        return (double)(int)_value;
+    case Type::FLOAT:
+        return (double)asFloat();
+    case Type::DOUBLE:
+        if ((uint64_t)_value + sizeof(double) <= _size)
+        {
+            double d;
+            memcpy(&d, _data + _value, sizeof(d));
+            return d;
+        }
+        return 0.0;
+    case Type::STRING:
+    case Type::STRING_FLOATS:
+        return utils::atof(asString());
+    default:
+        return 0.0;
+    }
+}
+
+bool ValueBinary::Item::asBool() const
+{
+    if (_type == Type::STRING || _type == Type::STRING_FLOATS)
+    {
+        const char* str = asString();
+        return !(strcmp(str, "0") == 0 || strcmp(str, "false") == 0);
+    }
+    if (_type == Type::FLOAT || _type == Type::DOUBLE)
+        return asDouble() != 0.0;
+    return _value != 0;
+}
+
+const char* ValueBinary::Item::asString() const
+{
+    if (_type == Type::STRING)
+        return string(_value);
+
+    if (_type == Type::STRING_FLOATS && (uint64_t)_value + 8 <= _size)
+        return string(readU32(_data + _value));
+
+    return "";
+}
+
+const float* ValueBinary::Item::getFloats(uint32_t* count) const
+{
+    if (_type != Type::STRING_FLOATS || (uint64_t)_value + 8 > _size)
+        return nullptr;
+
+    uint32_t n = readU32(_data + _value + 4);
+    if ((uint64_t)_value + 8 + (uint64_t)n * sizeof(float) > _size)
+        return nullptr;
+
+    *count = n;
+    return reinterpret_cast<const float*>(_data + _value + 8);
+}
+
+Vec2 ValueBinary::Item::asVec2() const
+{
+    uint32_t count = 0;
+    const float* floats = getFloats(&count);
+    if (floats == nullptr)
+        return PointFromString(asString());
+    if (count != 2)
+        return Vec2::ZERO;
+
+    float v[2];
+    memcpy(v, floats, sizeof(v));
+    return Vec2(v[0], v[1]);
+}
+
+Size ValueBinary::Item::asSize() const
+{
+    uint32_t count = 0;
+    const float* floats = getFloats(&count);
+    if (floats == nullptr)
+        return SizeFromString(asString());
+    if (count != 2)
+        return Size::ZERO;
+
+    float v[2];
+    memcpy(v, floats, sizeof(v));
+    return Size(v[0], v[1]);
+}
+
+Rect ValueBinary::Item::asRect() const
+{
+    uint32_t count = 0;
+    const float* floats = getFloats(&count);
+    if (floats == nullptr)
+        return RectFromString(asString());
+    if (count != 4)
+        return Rect::ZERO;
+
+    float v[4];
+    memcpy(v, floats, sizeof(v));
+    return Rect(v[0], v[1], v[2], v[3]);
+}
+
+uint32_t ValueBinary::Item::size() const
+{
+    uint32_t count = 0;
+    if (_type == Type::VECTOR)
+        container(RECORD_SIZE, &count);
+    else if (isMap())
+        container(MAP_ENTRY_SIZE, &count);
+    return count;
+}
+
+ValueBinary::Item ValueBinary::Item::at(uint32_t index) const
+{
+    uint32_t count = 0;
+    const unsigned char* records = _type == Type::VECTOR ? container(RECORD_SIZE, &count) : nullptr;
+    if (records == nullptr || index >= count)
+        return Item();
+    return Item(_data, _size, records + index * RECORD_SIZE);
+}
+
+ValueBinary::Item ValueBinary::Item::find(const char* key) const
+{
+    uint32_t count = 0;
+    const unsigned char* entries = _type == Type::MAP ? container(MAP_ENTRY_SIZE, &count) : nullptr;
+    if (entries == nullptr)
+        return Item();
+
+    uint32_t low = 0;
+    uint32_t high = count;
+    while (low < high)
+    {
+        uint32_t mid = low + (high - low) / 2;
+        const unsigned char* entry = entries + mid * MAP_ENTRY_SIZE;
+        int cmp = strcmp(key, string(readU32(entry)));
+        if (cmp == 0)
+            return Item(_data, _size, entry + 4);
+        if (cmp < 0)
+            high = mid;
+        else
+            low = mid + 1;
+    }
+    return Item();
+}
+
+ValueBinary::Item ValueBinary::Item::find(int key) const
+{
+    uint32_t count = 0;
+    const unsigned char* entries = _type == Type::INT_KEY_MAP ? container(MAP_ENTRY_SIZE, &count) : nullptr;
+    if (entries == nullptr)
+        return Item();
+
+    uint32_t low = 0;
+    uint32_t high = count;
+    while (low < high)
+    {
+        uint32_t mid = low + (high - low) / 2;
+        const unsigned char* entry = entries + mid * MAP_ENTRY_SIZE;
+        int entryKey = (int)readU32(entry);
+        if (key == entryKey)
+            return Item(_data, _size, entry + 4);
+        if (key < entryKey)
+            high = mid;
+        else
+            low = mid + 1;
+    }
+    return Item();
+}
+
+const char* ValueBinary::Item::keyAt(uint32_t index) const
+{
+    uint32_t count = 0;
+    const unsigned char* entries = _type == Type::MAP ? container(MAP_ENTRY_SIZE, &count) : nullptr;
+    if (entries == nullptr || index >= count)
+        return "";
+    return string(readU32(entries + index * MAP_ENTRY_SIZE));
+}
+
+int ValueBinary::Item::intKeyAt(uint32_t index) const
+{
+    uint32_t count = 0;
+    const unsigned char* entries = _type == Type::INT_KEY_MAP ? container(MAP_ENTRY_SIZE, &count) : nullptr;
+    if (entries == nullptr || index >= count)
+        return 0;
+    return (int)readU32(entries + index * MAP_ENTRY_SIZE);
+}
+
+ValueBinary::Item ValueBinary::Item::valueAt(uint32_t index) const
+{
+    uint32_t count = 0;
+    const unsigned char* entries = isMap() ? container(MAP_ENTRY_SIZE, &count) : nullptr;
+    if (entries == nullptr || index >= count)
+        return Item();
+    return Item(_data, _size, entries + index * MAP_ENTRY_SIZE + 4);
+}
+
+Value ValueBinary::Item::toValue() const
+{
+    switch (_type)
+    {
+    case Type::BYTE:
+        return Value((unsigned char)_value);
+    case Type::INTEGER:
+        return Value((int)_value);
+    case Type::UNSIGNED:
+        return Value((unsigned int)_value);
+    case Type::FLOAT:
+        return Value(asFloat());
+    case Type::DOUBLE:
+        return Value(asDouble());
+    case Type::BOOLEAN:
+        return Value(_value != 0);
+    case Type::STRING:
+    case Type::STRING_FLOATS:
+        return Value(asString());
+    case Type::VECTOR:
+        {
+            uint32_t count = size();
+            ValueVector vector;
+            vector.reserve(count);
+            for (uint32_t i = 0; i < count; ++i)
+                vector.push_back(at(i).toValue());
+            return Value(std::move(vector));
+        }
+    case Type::MAP:
+        {
+            uint32_t count = size();
+            ValueMap map;
+            map.reserve(count);
+            for (uint32_t i = 0; i < count; ++i)
+                map.emplace(keyAt(i), valueAt(i).toValue());
+            return Value(std::move(map));
+        }
+    case Type::INT_KEY_MAP:
+        {
+            uint32_t count = size();
+            ValueMapIntKey map;
+            map.reserve(count);
+            for (uint32_t i = 0; i < count; ++i)
+                map.emplace(intKeyAt(i), valueAt(i).toValue());
+            return Value(std::move(map));
+        }
+    default:
+        return Value::Null;
+    }
+}
+
+// ValueBinary
+
+bool ValueBinary::isValueBinary(const void* bytes, ssize_t size)
+{
+    if (bytes == nullptr || size < (ssize_t)HEADER_SIZE)
+        return false;
+
+    const unsigned char* p = static_cast<const unsigned char*>(bytes);
+    if (memcmp(p, VALUE_BINARY_MAGIC, sizeof(VALUE_BINARY_MAGIC)) != 0)
+        return false;
+
+    uint32_t version = readU32(p + OFFSET_VERSION);
+    if (version != VALUE_BINARY_VERSION)
+    {
+        if (version == swapU32(VALUE_BINARY_VERSION))
+            CCLOG("cocos2d: ValueBinary: the file was compiled with the other byte order, compile it again");
+        return false;
+    }
+
+    uint64_t stringsOffset = readU32(p + OFFSET_STRINGS);
+    uint64_t stringsSize = readU32(p + OFFSET_STRINGS_SIZE);
+    if (stringsOffset < HEADER_SIZE || stringsOffset + stringsSize > (uint64_t)size)
+        return false;
+
+    return stringsSize == 0 || p[stringsOffset + stringsSize - 1] == '\0';
+}
+
+Data ValueBinary::compile(const ValueMap& dict, uint32_t sourceHash, uint32_t sourceSize)
+{
+    Writer writer;
+    return writer.finish(dict, sourceHash, sourceSize);
+}
+
+bool ValueBinary::getSourceInfo(const void* bytes, ssize_t size, uint32_t* sourceHash, uint32_t* sourceSize)
+{
+    if (!isValueBinary(bytes, size))
+        return false;
+
+    const unsigned char* p = static_cast<const unsigned char*>(bytes);
+    if (sourceHash)
+        *sourceHash = readU32(p + OFFSET_SOURCE_HASH);
+    if (sourceSize)
+        *sourceSize = readU32(p + OFFSET_SOURCE_SIZE);
+    return true;
+}
+
+ValueBinary::Item ValueBinary::getRoot(const void* bytes, ssize_t size)
+{
+    if (!isValueBinary(bytes, size))
+        return Item();
+
+    const unsigned char* p = static_cast<const unsigned char*>(bytes);
+    Item root(p, (uint32_t)size, p + OFFSET_ROOT);
+    if (root.getType() != Type::MAP)
+        return Item();
+    return root;
+}
+
+ValueMap ValueBinary::toValueMap(const void* bytes, ssize_t size)
+{
+    Item root = getRoot(bytes, size);
+    if (root.isNull())
+    {
+        CCLOG("ValueBinary: invalid compiled data");
+        return ValueMap();
+    }
+    return std::move(root.toValue().asValueMap());
+}
+
+NS_CC_END
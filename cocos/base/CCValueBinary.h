@@ -0,0 +1,166 @@
+/****************************************************************************
+Copyright (c) 2017 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __CC_VALUE_BINARY_H__
+#define __CC_VALUE_BINARY_H__
+
+#include "platform/CCPlatformMacros.h"
+#include "base/CCValue.h"
+#include "base/CCData.h"
+#include "math/CCGeometry.h"
+#include <cstdint>
+
+/**
+ * @addtogroup base
+ * @{
+ */
+NS_CC_BEGIN
+
+/**
+ * @class ValueBinary
+ * @brief Compiled binary form of a ValueMap.
+ *
+ * A compiled file is a header, a block of fixed size records and a deduplicated
+ * string table. Map keys are sorted so lookups are binary searches, and strings
+ * of the "{x,y}", "{w,h}" and "{{x,y},{w,h}}" forms used by plist files carry
+ * their numbers pre-parsed. Everything is addressed by offset, so a compiled
+ * buffer can be walked in place through ValueBinary::Item without creating any
+ * Value.
+ *
+ * Use FileUtils::writeValueMapToBinaryFile to compile plist files offline; a
+ * compiled file can replace the plist under the same name.
+ *
+ * Numbers are stored in native byte order, so a file compiled on a little endian
+ * machine is only read on little endian machines, isValueBinary rejects the others.
+ * @since v3.17
+ * @js NA
+ * @lua NA
+ */
+class CC_DLL ValueBinary
+{
+public:
+    /** Record types. The first values match Value::Type. */
+    enum class Type : uint32_t
+    {
+        NONE = 0,
+        BYTE,
+        INTEGER,
+        UNSIGNED,
+        FLOAT,
+        DOUBLE,
+        BOOLEAN,
+        STRING,
+        VECTOR,
+        MAP,
+        INT_KEY_MAP,
+        /** A string that also stores the numbers it contains. */
+        STRING_FLOATS = 0x10
+    };
+
+    /**
+     * Read-only view of one value inside a compiled buffer.
+     * An Item is only valid as long as the buffer it points into.
+     */
+    class CC_DLL Item
+    {
+    public:
+        Item();
+
+        Type getType() const { return _type; }
+        bool isNull() const { return _type == Type::NONE; }
+        bool isMap() const { return _type == Type::MAP || _type == Type::INT_KEY_MAP; }
+        bool isVector() const { return _type == Type::VECTOR; }
+
+        int asInt() const;
+        float asFloat() const;
+        double asDouble() const;
+        bool asBool() const;
+        /** Returns the string, or an empty string if this is not a string. */
+        const char* asString() const;
+
+        /** Returns the pre-parsed numbers of a "{...}" string, or nullptr. */
+        const float* getFloats(uint32_t* count) const;
+        /** Same result as PointFromString(asString()). */
+        Vec2 asVec2() const;
+        /** Same result as SizeFromString(asString()). */
+        Size asSize() const;
+        /** Same result as RectFromString(asString()). */
+        Rect asRect() const;
+
+        /** Number of elements of a vector or entries of a map, 0 otherwise. */
+        uint32_t size() const;
+        /** Element of a vector. */
+        Item at(uint32_t index) const;
+        /** Looks up a string key in a map. Returns a null Item if not found. */
+        Item find(const char* key) const;
+        /** Looks up an int key in an int key map. Returns a null Item if not found. */
+        Item find(int key) const;
+        /** Key of the map entry at index, for iterating. Empty for int key maps. */
+        const char* keyAt(uint32_t index) const;
+        /** Int key of the int key map entry at index. */
+        int intKeyAt(uint32_t index) const;
+        /** Value of the map entry at index. */
+        Item valueAt(uint32_t index) const;
+
+        /** Converts this item and its children to a Value. */
+        Value toValue() const;
+
+    private:
+        friend class ValueBinary;
+        Item(const unsigned char* data, uint32_t size, const unsigned char* record);
+
+        const unsigned char* container(uint32_t entrySize, uint32_t* count) const;
+        const char* string(uint32_t offset) const;
+
+        const unsigned char* _data;
+        uint32_t _size;
+        Type _type;
+        uint32_t _value;
+    };
+
+    /** Returns true if the bytes start with a valid compiled header. */
+    static bool isValueBinary(const void* bytes, ssize_t size);
+
+    /**
+     * Compiles a ValueMap.
+     * @param sourceHash, sourceSize Identify the source the map was read from, so
+     * cached copies can be validated with getSourceInfo.
+     */
+    static Data compile(const ValueMap& dict, uint32_t sourceHash = 0, uint32_t sourceSize = 0);
+
+    /** Reads back the source identification passed to compile. */
+    static bool getSourceInfo(const void* bytes, ssize_t size, uint32_t* sourceHash, uint32_t* sourceSize);
+
+    /** Returns the root map of a compiled buffer, or a null Item if the buffer is invalid. */
+    static Item getRoot(const void* bytes, ssize_t size);
+
+    /** Converts a compiled buffer back to a ValueMap. */
+    static ValueMap toValueMap(const void* bytes, ssize_t size);
+};
+
+NS_CC_END
+// end of base group
+/** @} */
+
+#endif /* __CC_VALUE_BINARY_H__ */
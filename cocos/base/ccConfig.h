@@ -164,6 +164,37 @@ THE SOFTWARE.
 #define CC_TEXTURE_ATLAS_USE_VAO 1
 #endif
 
+/** @def CC_RENDERER_USE_STREAMING_VBO
+ * If enabled, the Renderer streams batched TrianglesCommand vertices through a ring of fence-guarded
+ * buffers (persistently mapped when GL_ARB_buffer_storage is available) instead of orphaning one VBO per flush.
+ * Vertices are then written directly into GPU-visible memory without the intermediate copy.
+ * It requires glMapBufferRange() and glFenceSync(), so it is only available on desktop OpenGL.
+ * The feature is still checked at runtime, and it falls back to the old path when the driver lacks the extensions.
+ * @since v3.17
+ */
+#ifndef CC_RENDERER_USE_STREAMING_VBO
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX || CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+#define CC_RENDERER_USE_STREAMING_VBO 1
+#else
+#define CC_RENDERER_USE_STREAMING_VBO 0
+#endif
+#endif
+
+/** @def CC_USE_GL_PROGRAM_BINARY_CACHE
+ * If enabled, GLProgramCache can store the linked default programs (glGetProgramBinary) under the writable path,
+ * and load them on the next launch instead of compiling the shaders again (see GLProgramCache::setBinaryCacheEnabled).
+ * It requires GL_ARB_get_program_binary on desktop, or GL_OES_get_program_binary on Android.
+ * The extension is still checked at runtime.
+ * @since v3.17
+ */
+#ifndef CC_USE_GL_PROGRAM_BINARY_CACHE
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX || CC_TARGET_PLATFORM == CC_PLATFORM_WIN32 || CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID)
+#define CC_USE_GL_PROGRAM_BINARY_CACHE 1
+#else
+#define CC_USE_GL_PROGRAM_BINARY_CACHE 0
+#endif
+#endif
+
 
 /** @def CC_USE_LA88_LABELS
  * If enabled, it will use LA88 (Luminance Alpha 16-bit textures) for LabelTTF objects.
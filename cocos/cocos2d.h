@@ -39,6 +39,7 @@ THE SOFTWARE.
 
 // base
 #include "base/CCAsyncTaskPool.h"
+#include "base/CCJobSystem.h"
 #include "base/CCAutoreleasePool.h"
 #include "base/CCConfiguration.h"
 #include "base/CCConsole.h"
@@ -55,6 +56,8 @@ THE SOFTWARE.
 #include "base/CCScheduler.h"
 #include "base/CCUserDefault.h"
 #include "base/CCValue.h"
+#include "base/CCValueBinary.h"
+#include "base/CCPackFile.h"
 #include "base/CCVector.h"
 #include "base/ZipUtils.h"
 #include "base/base64.h"
@@ -131,6 +134,7 @@ THE SOFTWARE.
 #include "2d/CCParticleExamples.h"
 #include "2d/CCParticleSystem.h"
 #include "2d/CCParticleSystemQuad.h"
+#include "2d/CCParticleSystemManager.h"
 #include "2d/CCProgressTimer.h"
 #include "2d/CCProtectedNode.h"
 #include "2d/CCRenderTexture.h"
@@ -956,7 +956,7 @@ Node* CSLoader::nodeWithFlatBuffersFile(const std::string &fileName, const ccNod
     
     CC_ASSERT(FileUtils::getInstance()->isFileExist(fullPath));
 
-    Data buf = FileUtils::getInstance()->getDataFromFile(fullPath);
+    Data buf = FileUtils::getInstance()->getMappedDataFromFile(fullPath);
 
     if (buf.isNull())
     {
@@ -1024,7 +1024,7 @@ Node* CSLoader::nodeWithFlatBuffers(const flatbuffers::NodeTree *nodetree, const
             cocostudio::timeline::ActionTimeline* action = nullptr;
             if (filePath != "" && FileUtils::getInstance()->isFileExist(filePath))
             {
-                Data buf = FileUtils::getInstance()->getDataFromFile(filePath);
+                Data buf = FileUtils::getInstance()->getMappedDataFromFile(filePath);
                 node = createNode(buf, callback);
                 action = createTimeline(buf, filePath);
             }
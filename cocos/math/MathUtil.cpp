@@ -67,6 +67,9 @@ This file was modified to fit the cocos2d-x project
 #endif
 
 #ifdef INCLUDE_SSE
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
 #include "math/MathUtilSSE.inl"
 #endif
 
@@ -275,4 +278,25 @@ void MathUtil::crossVec3(const float* v1, const float* v2, float* dst)
 #endif
 }
 
+void MathUtil::transformVertices(const float* m, const void* src, void* dst, size_t count, size_t stride)
+{
+    GP_ASSERT(stride >= sizeof(float) * 3);
+    if (count == 0)
+        return;
+
+#ifdef USE_NEON32
+    MathUtilNeon::transformVertices(m, src, dst, count, stride);
+#elif defined (USE_NEON64)
+    MathUtilNeon64::transformVertices(m, src, dst, count, stride);
+#elif defined (INCLUDE_NEON32)
+    if(isNeon32Enabled()) MathUtilNeon::transformVertices(m, src, dst, count, stride);
+    else MathUtilC::transformVertices(m, src, dst, count, stride);
+#elif defined (USE_SSE)
+    const __m128 col[4] = { _mm_loadu_ps(m), _mm_loadu_ps(m + 4), _mm_loadu_ps(m + 8), _mm_loadu_ps(m + 12) };
+    transformVertices(col, src, dst, count, stride);
+#else
+    MathUtilC::transformVertices(m, src, dst, count, stride);
+#endif
+}
+
 NS_CC_MATH_END
@@ -87,6 +87,26 @@ public:
      * @return interpolated float value
      */
     static float lerp(float from, float to, float alpha);
+
+    /**
+     * Transforms an array of points by a matrix, as Mat4::transformPoint() does (w = 1).
+     *
+     * The points are the first 3 floats of elements `stride` bytes apart, so vertex arrays
+     * whose position comes first (like V3F_C4B_T2F) are transformed directly.
+     * Uses SSE/AVX or NEON when available.
+     *
+     * @param m the matrix (Mat4::m).
+     * @param src the first point to transform.
+     * @param dst the first point to write. It may be the same as src.
+     * @param count the number of points.
+     * @param stride the distance in bytes between two points, at least 3 floats.
+     */
+    static void transformVertices(const float* m, const void* src, void* dst, size_t count, size_t stride);
+
+    /**
+     * Transforms an array of points in place, see transformVertices(const float*, const void*, void*, size_t, size_t).
+     */
+    static void transformVertices(const float* m, void* vertices, size_t count, size_t stride) { transformVertices(m, vertices, vertices, count, stride); }
 private:
     //Indicates that if neon is enabled
     static bool isNeon32Enabled();
@@ -108,6 +128,8 @@ private:
     static void transposeMatrix(const __m128 m[4], __m128 dst[4]);
         
     static void transformVec4(const __m128 m[4], const __m128& v, __m128& dst);
+
+    static void transformVertices(const __m128 m[4], const void* src, void* dst, size_t count, size_t stride);
 #endif
     static void addMatrix(const float* m, float scalar, float* dst);
 
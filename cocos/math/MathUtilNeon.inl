@@ -41,6 +41,8 @@ public:
     inline static void transformVec4(const float* m, const float* v, float* dst);
     
     inline static void crossVec3(const float* v1, const float* v2, float* dst);
+
+    inline static void transformVertices(const float* m, const void* src, void* dst, size_t count, size_t stride);
 };
 
 inline void MathUtilNeon::addMatrix(const float* m, float scalar, float* dst)
@@ -268,4 +270,32 @@ inline void MathUtilNeon::crossVec3(const float* v1, const float* v2, float* dst
                  );
 }
 
+inline void MathUtilNeon::transformVertices(const float* m, const void* src, void* dst, size_t count, size_t stride)
+{
+    const char* in = (const char*) src;
+    char* out = (char*) dst;
+    // x, y and z are read/written with post-increments of 8 then (stride - 8) bytes
+    size_t skip = stride - 8;
+    asm volatile(
+                 "vld1.32    {d18 - d21},    [%3]!   \n\t"    // M[m0-m7]
+                 "vld1.32    {d22 - d25},    [%3]    \n\t"    // M[m8-m15]
+                 "1:                                 \n\t"
+                 "vld1.32    {d0},           [%0]!   \n\t"    // V[x, y]
+                 "vld1.32    {d1[0]},        [%0], %4 \n\t"   // V[z]
+                 
+                 "vmov       q13, q12                \n\t"    // DST->V = M[m12-m15]
+                 "vmla.f32   q13, q9, d0[0]          \n\t"    // DST->V += M[m0-m3] * V[x]
+                 "vmla.f32   q13, q10, d0[1]         \n\t"    // DST->V += M[m4-m7] * V[y]
+                 "vmla.f32   q13, q11, d1[0]         \n\t"    // DST->V += M[m8-m11] * V[z]
+                 
+                 "vst1.32    {d26},          [%1]!   \n\t"    // DST->V[x, y]
+                 "vst1.32    {d27[0]},       [%1], %4 \n\t"   // DST->V[z]
+                 "subs       %2, %2, #1              \n\t"
+                 "bne        1b                      \n\t"
+                 : "+r"(in), "+r"(out), "+r"(count), "+r"(m)
+                 : "r"(skip)
+                 : "q0", "q9", "q10", "q11", "q12", "q13", "cc", "memory"
+                 );
+}
+
 NS_CC_MATH_END
@@ -42,6 +42,8 @@ public:
     inline static void transformVec4(const float* m, const float* v, float* dst);
     
     inline static void crossVec3(const float* v1, const float* v2, float* dst);
+
+    inline static void transformVertices(const float* m, const void* src, void* dst, size_t count, size_t stride);
 };
 
 inline void MathUtilNeon64::addMatrix(const float* m, float scalar, float* dst)
@@ -262,4 +264,31 @@ inline void MathUtilNeon64::crossVec3(const float* v1, const float* v2, float* d
     );
 }
 
+inline void MathUtilNeon64::transformVertices(const float* m, const void* src, void* dst, size_t count, size_t stride)
+{
+    const char* in = (const char*) src;
+    char* out = (char*) dst;
+    // x, y and z are read/written with post-increments of 8 then (stride - 8) bytes
+    size_t skip = stride - 8;
+    asm volatile(
+        "ld1    {v9.4s, v10.4s, v11.4s, v12.4s}, [%3] \n\t"   // M[m0-m7] M[m8-m15]
+        "1:                                     \n\t"
+        "ld1    {v0.2s}, [%0], #8               \n\t"   // V[x, y]
+        "ld1    {v0.s}[2], [%0], %4             \n\t"   // V[z]
+
+        "mov    v13.16b, v12.16b                \n\t"   // DST->V = M[m12-m15]
+        "fmla   v13.4s, v9.4s, v0.s[0]          \n\t"   // DST->V += M[m0-m3] * V[x]
+        "fmla   v13.4s, v10.4s, v0.s[1]         \n\t"   // DST->V += M[m4-m7] * V[y]
+        "fmla   v13.4s, v11.4s, v0.s[2]         \n\t"   // DST->V += M[m8-m11] * V[z]
+
+        "st1    {v13.2s}, [%1], #8              \n\t"   // DST->V[x, y]
+        "st1    {v13.s}[2], [%1], %4            \n\t"   // DST->V[z]
+        "subs   %2, %2, #1                      \n\t"
+        "b.ne   1b                              \n\t"
+        : "+r"(in), "+r"(out), "+r"(count)
+        : "r"(m), "r"(skip)
+        : "v0", "v9", "v10", "v11", "v12", "v13", "cc", "memory"
+    );
+}
+
 NS_CC_MATH_END
@@ -151,6 +151,63 @@ void MathUtil::transformVec4(const __m128 m[4], const __m128& v, __m128& dst)
                      );
 }
 
+void MathUtil::transformVertices(const __m128 m[4], const void* src, void* dst, size_t count, size_t stride)
+{
+    const char* in = (const char*) src;
+    char* out = (char*) dst;
+    size_t i = 0;
+
+#ifdef __AVX__
+    // Two points per iteration, one in each 128-bit lane
+    const __m256 col1 = _mm256_insertf128_ps(_mm256_castps128_ps256(m[0]), m[0], 1);
+    const __m256 col2 = _mm256_insertf128_ps(_mm256_castps128_ps256(m[1]), m[1], 1);
+    const __m256 col3 = _mm256_insertf128_ps(_mm256_castps128_ps256(m[2]), m[2], 1);
+    const __m256 col4 = _mm256_insertf128_ps(_mm256_castps128_ps256(m[3]), m[3], 1);
+
+    for (; i + 1 < count; i += 2, in += stride * 2, out += stride * 2)
+    {
+        const float* v0 = (const float*) in;
+        const float* v1 = (const float*) (in + stride);
+
+        __m256 x = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load1_ps(v0)), _mm_load1_ps(v1), 1);
+        __m256 y = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load1_ps(v0 + 1)), _mm_load1_ps(v1 + 1), 1);
+        __m256 z = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load1_ps(v0 + 2)), _mm_load1_ps(v1 + 2), 1);
+
+#ifdef __FMA__
+        __m256 r = _mm256_fmadd_ps(col1, x, _mm256_fmadd_ps(col2, y, _mm256_fmadd_ps(col3, z, col4)));
+#else
+        __m256 r = _mm256_add_ps(
+                                 _mm256_add_ps(_mm256_mul_ps(col1, x), _mm256_mul_ps(col2, y)),
+                                 _mm256_add_ps(_mm256_mul_ps(col3, z), col4)
+                                 );
+#endif
+        __m128 r0 = _mm256_castps256_ps128(r);
+        __m128 r1 = _mm256_extractf128_ps(r, 1);
+
+        float* d0 = (float*) out;
+        float* d1 = (float*) (out + stride);
+        _mm_storel_pi((__m64*) d0, r0);
+        _mm_store_ss(d0 + 2, _mm_movehl_ps(r0, r0));
+        _mm_storel_pi((__m64*) d1, r1);
+        _mm_store_ss(d1 + 2, _mm_movehl_ps(r1, r1));
+    }
+#endif
+
+    for (; i < count; ++i, in += stride, out += stride)
+    {
+        const float* v = (const float*) in;
+        float* d = (float*) out;
+
+        __m128 r = _mm_add_ps(
+                              _mm_add_ps(_mm_mul_ps(m[0], _mm_load1_ps(v)), _mm_mul_ps(m[1], _mm_load1_ps(v + 1))),
+                              _mm_add_ps(_mm_mul_ps(m[2], _mm_load1_ps(v + 2)), m[3])
+                              );
+
+        _mm_storel_pi((__m64*) d, r);
+        _mm_store_ss(d + 2, _mm_movehl_ps(r, r));
+    }
+}
+
 #endif
 
 
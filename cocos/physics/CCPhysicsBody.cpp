@@ -103,6 +103,9 @@ PhysicsBody::PhysicsBody()
 , _momentSetByUser(false)
 , _recordScaleX(1.f)
 , _recordScaleY(1.f)
+, _previousRotation(0.f)
+, _interpolated(false)
+, _interpolatedRotation(0.f)
 {
     _name = COMPONENT_NAME;
 }
@@ -888,6 +891,26 @@ void PhysicsBody::beforeSimulation(const Mat4& parentToWorldTransform, const Mat
         setScale(scaleX, scaleY);
     }
 
+    auto worldPosition = _ownerCenterOffset;
+    nodeToWorldTransform.transformVector(worldPosition.x, worldPosition.y, worldPosition.z, 1.f, &worldPosition);
+
+    if (_interpolated)
+    {
+        _interpolated = false;
+
+        // the node was not moved since it was interpolated, the body keeps its simulated state
+        static const float INTERPOLATION_TOLERANCE = 0.01f;
+        if (std::abs(worldPosition.x - _interpolatedPosition.x) < INTERPOLATION_TOLERANCE &&
+            std::abs(worldPosition.y - _interpolatedPosition.y) < INTERPOLATION_TOLERANCE &&
+            std::abs(rotation - _interpolatedRotation) < INTERPOLATION_TOLERANCE)
+        {
+            auto position = getPosition();
+            _recordPosX = position.x;
+            _recordPosY = position.y;
+            return;
+        }
+    }
+
     // set rotation
     if (_recordedRotation != rotation)
     {
@@ -895,10 +918,12 @@ void PhysicsBody::beforeSimulation(const Mat4& parentToWorldTransform, const Mat
     }
 
     // set position
-    auto worldPosition = _ownerCenterOffset;
-    nodeToWorldTransform.transformVector(worldPosition.x, worldPosition.y, worldPosition.z, 1.f, &worldPosition);
     setPosition(worldPosition.x, worldPosition.y);
 
+    // the body was moved by its node, don't interpolate from the old state
+    _previousPosition.set(worldPosition.x, worldPosition.y);
+    _previousRotation = rotation;
+
     _recordPosX = worldPosition.x;
     _recordPosY = worldPosition.y;
 
@@ -925,6 +950,28 @@ void PhysicsBody::afterSimulation(const Mat4& parentToWorldTransform, float pare
     _owner->setRotation(getRotation() - parentRotation);
 }
 
+void PhysicsBody::afterSimulation(const Mat4& parentToWorldTransform, float parentRotation, float alpha)
+{
+    auto position = getPosition();
+    position = _previousPosition + (position - _previousPosition) * alpha;
+    float rotation = _previousRotation + (getRotation() - _previousRotation) * alpha;
+
+    _interpolated = true;
+    _interpolatedPosition = position;
+    _interpolatedRotation = rotation;
+
+    Vec3 positionInParent(position.x, position.y, 0.f);
+    parentToWorldTransform.getInversed().transformVector(positionInParent.x, positionInParent.y, positionInParent.z, 1.f, &positionInParent);
+    _owner->setPosition(positionInParent.x - _offset.x, positionInParent.y - _offset.y);
+    _owner->setRotation(rotation - parentRotation);
+}
+
+void PhysicsBody::recordPreviousState()
+{
+    _previousPosition = getPosition();
+    _previousRotation = getRotation();
+}
+
 void PhysicsBody::onEnter()
 {
     addToPhysicsWorld();
@@ -516,6 +516,10 @@ protected:
 
     void beforeSimulation(const Mat4& parentToWorldTransform, const Mat4& nodeToWorldTransform, float scaleX, float scaleY, float rotation);
     void afterSimulation(const Mat4& parentToWorldTransform, float parentRotation);
+    // places the node between the state before the last fixed step and the current one
+    void afterSimulation(const Mat4& parentToWorldTransform, float parentRotation, float alpha);
+    // records the state before a fixed step, for the interpolation
+    void recordPreviousState();
 protected:
     std::vector<PhysicsJoint*> _joints;
     Vector<PhysicsShape*> _shapes;
@@ -559,6 +563,14 @@ protected:
     float _recordPosX;
     float _recordPosY;
 
+    // state before the last fixed step
+    Vec2 _previousPosition;
+    float _previousRotation;
+    // the node shows an interpolated state, that must not be copied back to the body
+    bool _interpolated;
+    Vec2 _interpolatedPosition;
+    float _interpolatedRotation;
+
     friend class PhysicsWorld;
     friend class PhysicsShape;
     friend class PhysicsJoint;
@@ -39,6 +39,7 @@
 #include "base/CCDirector.h"
 #include "base/CCEventDispatcher.h"
 #include "base/CCEventCustom.h"
+#include "base/CCJobSystem.h"
 
 NS_CC_BEGIN
 const float PHYSICS_INFINITY = FLT_MAX;
@@ -490,7 +491,7 @@ bool PhysicsWorld::init()
 		_cpSpace = cpSpaceNew();
 #else
         _cpSpace = cpHastySpaceNew();
-        cpHastySpaceSetThreads(_cpSpace, 0);
+        cpHastySpaceSetThreads(_cpSpace, _solverThreads);
 #endif
         CC_BREAK_IF(_cpSpace == nullptr);
         
@@ -880,7 +881,7 @@ void PhysicsWorld::update(float delta, bool userCall/* = false*/)
     }
     
     auto sceneToWorldTransform = _scene->getNodeToParentTransform();
-    beforeSimulation(_scene, sceneToWorldTransform, 1.f, 1.f, 0.f);
+    beforeSimulation(sceneToWorldTransform);
 
     if (!_delayAddJoints.empty() || !_delayRemoveJoints.empty())
     {
@@ -907,9 +908,25 @@ void PhysicsWorld::update(float delta, bool userCall/* = false*/)
         {
             const float step = 1.0f / _fixedRate;
             const float dt = step * _speed;
+            int steps = 0;
             while(_updateTime>step)
             {
+                if (_maxFixedSteps > 0 && steps >= _maxFixedSteps)
+                {
+                    // out of budget, drop the time instead of catching up in the next frames
+                    _updateTime = fmodf(_updateTime, step);
+                    break;
+                }
                 _updateTime-=step;
+                ++steps;
+
+                if (_fixedStepInterpolation)
+                {
+                    for (auto& body : _bodies)
+                    {
+                        body->recordPreviousState();
+                    }
+                }
 #if CC_TARGET_PLATFORM == CC_PLATFORM_WINRT || CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
 				cpSpaceStep(_cpSpace, dt);
 #else
@@ -929,10 +946,7 @@ void PhysicsWorld::update(float delta, bool userCall/* = false*/)
 #else
 					cpHastySpaceStep(_cpSpace, dt);
 #endif 
-					for (auto& body : _bodies)
-                    {
-                        body->update(dt);
-                    }
+                    updateBodiesDamping(dt);
                 }
                 _updateRateCount = 0;
                 _updateTime = 0.0f;
@@ -945,9 +959,46 @@ void PhysicsWorld::update(float delta, bool userCall/* = false*/)
         debugDraw();
     }
 
-    // Update physics position, should loop as the same sequence as node tree.
-    // PhysicsWorld::afterSimulation() will depend on the sequence.
-    afterSimulation(_scene, sceneToWorldTransform, 0.f);
+    // Update the nodes from the physics positions.
+    afterSimulation(sceneToWorldTransform, !userCall && _fixedRate && _fixedStepInterpolation);
+}
+
+void PhysicsWorld::updateBodiesDamping(float dt)
+{
+    // each body only touches its own cpBody, so the bodies can be updated in parallel
+    static const size_t PARALLEL_GRAIN = 512;
+    if (_solverThreads != 1 && _bodies.size() > PARALLEL_GRAIN)
+    {
+        JobSystem::getInstance()->parallelFor(_bodies.size(), PARALLEL_GRAIN, [this, dt](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                _bodies.at(i)->update(dt);
+            }
+        });
+    }
+    else
+    {
+        for (auto& body : _bodies)
+        {
+            body->update(dt);
+        }
+    }
+}
+
+void PhysicsWorld::setSolverThreads(int threads)
+{
+    if (threads < 0)
+    {
+        return;
+    }
+
+    _solverThreads = threads;
+#if CC_TARGET_PLATFORM != CC_PLATFORM_WINRT && CC_TARGET_PLATFORM != CC_PLATFORM_WIN32
+    if (_cpSpace)
+    {
+        cpHastySpaceSetThreads(_cpSpace, threads);
+    }
+#endif
 }
 
 PhysicsWorld* PhysicsWorld::construct(Scene* scene)
@@ -972,6 +1023,9 @@ PhysicsWorld::PhysicsWorld()
 , _updateTime(0.0f)
 , _substeps(1)
 , _fixedRate(0)
+, _maxFixedSteps(0)
+, _fixedStepInterpolation(false)
+, _solverThreads(0)
 , _cpSpace(nullptr)
 , _updateBodyTransform(false)
 , _scene(nullptr)
@@ -998,37 +1052,107 @@ PhysicsWorld::~PhysicsWorld()
     CC_SAFE_RELEASE_NULL(_debugDraw);
 }
 
-void PhysicsWorld::beforeSimulation(Node *node, const Mat4& parentToWorldTransform, float nodeParentScaleX, float nodeParentScaleY, float parentRotation)
+const PhysicsWorld::NodeWorldTransform* PhysicsWorld::getWorldTransform(Node* node, const Mat4& sceneToWorldTransform)
 {
-    auto scaleX = nodeParentScaleX * node->getScaleX();
-    auto scaleY = nodeParentScaleY * node->getScaleY();
-    auto rotation = parentRotation + node->getRotation();
-
-    auto nodeToWorldTransform = parentToWorldTransform * node->getNodeToParentTransform();
+    auto it = _worldTransforms.find(node);
+    if (it != _worldTransforms.end())
+    {
+        return &it->second;
+    }
 
-    auto physicsBody = node->getPhysicsBody();
-    if (physicsBody)
+    NodeWorldTransform transform;
+    if (node == _scene)
     {
-        physicsBody->beforeSimulation(parentToWorldTransform, nodeToWorldTransform, scaleX, scaleY, rotation);
+        transform.nodeToWorld = sceneToWorldTransform * node->getNodeToParentTransform();
+        transform.scaleX = node->getScaleX();
+        transform.scaleY = node->getScaleY();
+        transform.rotation = node->getRotation();
+    }
+    else
+    {
+        auto parent = node->getParent();
+        auto parentTransform = parent ? getWorldTransform(parent, sceneToWorldTransform) : nullptr;
+        if (parentTransform == nullptr)
+        {
+            return nullptr;
+        }
+        transform.nodeToWorld = parentTransform->nodeToWorld * node->getNodeToParentTransform();
+        transform.scaleX = parentTransform->scaleX * node->getScaleX();
+        transform.scaleY = parentTransform->scaleY * node->getScaleY();
+        transform.rotation = parentTransform->rotation + node->getRotation();
     }
 
-    for (auto child : node->getChildren())
-        beforeSimulation(child, nodeToWorldTransform, scaleX, scaleY, rotation);
+    // the elements of an unordered_map don't move, the children can keep a pointer to their parent's
+    return &_worldTransforms.emplace(node, transform).first->second;
 }
 
-void PhysicsWorld::afterSimulation(Node *node, const Mat4& parentToWorldTransform, float parentRotation)
+void PhysicsWorld::beforeSimulation(const Mat4& sceneToWorldTransform)
 {
-    auto nodeToWorldTransform = parentToWorldTransform * node->getNodeToParentTransform();
-    auto nodeRotation = parentRotation + node->getRotation();
+    // Only the bodies and their ancestors are visited, each node once: the siblings share their parent's transform.
+    _worldTransforms.clear();
+    for (auto& body : _bodies)
+    {
+        auto node = body->getNode();
+        auto nodeTransform = getWorldTransform(node, sceneToWorldTransform);
+        if (nodeTransform == nullptr)
+        {
+            continue;
+        }
 
-    auto physicsBody = node->getPhysicsBody();
-    if (physicsBody)
+        if (node == _scene)
+        {
+            body->beforeSimulation(sceneToWorldTransform, nodeTransform->nodeToWorld, nodeTransform->scaleX, nodeTransform->scaleY, nodeTransform->rotation);
+        }
+        else
+        {
+            auto parentTransform = getWorldTransform(node->getParent(), sceneToWorldTransform);
+            body->beforeSimulation(parentTransform->nodeToWorld, nodeTransform->nodeToWorld, nodeTransform->scaleX, nodeTransform->scaleY, nodeTransform->rotation);
+        }
+    }
+}
+
+void PhysicsWorld::afterSimulation(const Mat4& sceneToWorldTransform, bool interpolate)
+{
+    const float alpha = getFixedStepAlpha();
+
+    // The contact callbacks may have moved nodes during the step, so the transforms are computed again.
+    // They are all computed before any node is moved: a body always uses the transform of its parent
+    // from before the update, whatever the order of the bodies.
+    _worldTransforms.clear();
+    for (auto& body : _bodies)
     {
-        physicsBody->afterSimulation(parentToWorldTransform, parentRotation);
+        auto node = body->getNode();
+        if (node != _scene && node->getParent())
+        {
+            getWorldTransform(node->getParent(), sceneToWorldTransform);
+        }
     }
 
-    for (auto child : node->getChildren())
-        afterSimulation(child, nodeToWorldTransform, nodeRotation);
+    for (auto& body : _bodies)
+    {
+        auto node = body->getNode();
+        const Mat4* parentToWorldTransform = &sceneToWorldTransform;
+        float parentRotation = 0.f;
+        if (node != _scene)
+        {
+            auto it = _worldTransforms.find(node->getParent());
+            if (it == _worldTransforms.end())
+            {
+                continue;
+            }
+            parentToWorldTransform = &it->second.nodeToWorld;
+            parentRotation = it->second.rotation;
+        }
+
+        if (interpolate)
+        {
+            body->afterSimulation(*parentToWorldTransform, parentRotation, alpha);
+        }
+        else
+        {
+            body->afterSimulation(*parentToWorldTransform, parentRotation);
+        }
+    }
 }
 
 NS_CC_END
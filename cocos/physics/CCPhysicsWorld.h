@@ -29,6 +29,8 @@
 #if CC_USE_PHYSICS
 
 #include <list>
+#include <algorithm>
+#include <unordered_map>
 #include "base/CCVector.h"
 #include "math/CCGeometry.h"
 #include "physics/CCPhysicsBody.h"
@@ -301,6 +303,57 @@ public:
     /** get the number of substeps */
     int getFixedUpdateRate() const { return _fixedRate; }
 
+    /**
+     * Set the maximum number of fixed steps run in a frame, see setFixedUpdateRate().
+     * When a slow frame would need more steps, the time left is dropped instead of being caught up
+     * in the next frames, so a hitch doesn't cause a burst of steps.
+     * 0 - no limit
+     * default value is 0
+     * @since v3.17
+     */
+    void setMaxFixedStepsPerFrame(int steps) { if(steps >= 0) { _maxFixedSteps = steps; } }
+    /** get the maximum number of fixed steps run in a frame
+     * @since v3.17
+     */
+    int getMaxFixedStepsPerFrame() const { return _maxFixedSteps; }
+
+    /**
+     * Set whether the nodes are interpolated between the last two fixed steps, see setFixedUpdateRate().
+     * The bodies still move by fixed steps, but the nodes are placed between the previous and the current
+     * state of their body, according to getFixedStepAlpha(), so the motion is smooth at low rates.
+     * Moving a node still moves its body.
+     * default value is false
+     * @since v3.17
+     */
+    void setFixedStepInterpolationEnabled(bool enabled) { _fixedStepInterpolation = enabled; }
+    /** whether the nodes are interpolated between the last two fixed steps
+     * @since v3.17
+     */
+    bool isFixedStepInterpolationEnabled() const { return _fixedStepInterpolation; }
+
+    /**
+     * Get the time accumulated since the last fixed step, as a fraction of the step, between 0 and 1.
+     * It is the interpolation factor between the last two fixed steps, 0 when the fixed step system is disabled.
+     * @since v3.17
+     */
+    float getFixedStepAlpha() const { return _fixedRate ? std::min(_updateTime * _fixedRate, 1.0f) : 0.0f; }
+
+    /**
+     * Set the number of threads used to solve a step of the physics world.
+     * The chipmunk solver is run by this number of threads, and the per body update of the substeps
+     * is split across the JobSystem workers unless it is 1.
+     * 0 - one thread per core, chipmunk caps it to its own maximum
+     * 1 - the step is solved on the cocos thread only
+     * default value is 0
+     * @attention Chipmunk's threaded solver isn't built on Windows, the chipmunk step is always serial there.
+     * @since v3.17
+     */
+    void setSolverThreads(int threads);
+    /** get the number of threads used to solve a step of the physics world
+     * @since v3.17
+     */
+    int getSolverThreads() const { return _solverThreads; }
+
     /**
     * Set the debug draw mask of this physics world.
     * 
@@ -366,6 +419,7 @@ protected:
     virtual void removeBodyOrDelay(PhysicsBody* body);
     virtual void updateBodies();
     virtual void updateJoints();
+    void updateBodiesDamping(float dt);
     
 protected:
     Vec2 _gravity;
@@ -375,6 +429,9 @@ protected:
     float _updateTime;
     int _substeps;
     int _fixedRate;
+    int _maxFixedSteps;
+    bool _fixedStepInterpolation;
+    int _solverThreads;
     cpSpace* _cpSpace;
     
     bool _updateBodyTransform;
@@ -392,13 +449,26 @@ protected:
     Vector<PhysicsBody*> _delayRemoveBodies;
     std::vector<PhysicsJoint*> _delayAddJoints;
     std::vector<PhysicsJoint*> _delayRemoveJoints;
+
+    // world transform of a node, with the scale and rotation accumulated from the scene
+    struct NodeWorldTransform
+    {
+        Mat4 nodeToWorld;
+        float scaleX;
+        float scaleY;
+        float rotation;
+    };
+    // transforms of the bodies' nodes and of their ancestors, computed once per simulation pass
+    std::unordered_map<Node*, NodeWorldTransform> _worldTransforms;
     
 protected:
     PhysicsWorld();
     virtual ~PhysicsWorld();
     
-    void beforeSimulation(Node *node, const Mat4& parentToWorldTransform, float nodeParentScaleX, float nodeParentScaleY, float parentRotation);
-    void afterSimulation(Node* node, const Mat4& parentToWorldTransform, float parentRotation);
+    void beforeSimulation(const Mat4& sceneToWorldTransform);
+    void afterSimulation(const Mat4& sceneToWorldTransform, bool interpolate);
+    // returns nullptr if the node is not in the scene
+    const NodeWorldTransform* getWorldTransform(Node* node, const Mat4& sceneToWorldTransform);
 
     friend class Node;
     friend class Sprite;
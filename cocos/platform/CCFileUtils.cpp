@@ -26,11 +26,15 @@ THE SOFTWARE.
 #include "platform/CCFileUtils.h"
 
 #include <stack>
+#include <algorithm>
 
 #include "base/CCData.h"
 #include "base/ccMacros.h"
 #include "base/CCDirector.h"
 #include "platform/CCSAXParser.h"
+#include "base/CCValueBinary.h"
+#include "base/CCPackFile.h"
+#include "xxhash.h"
 //#include "base/ccUtils.h"
 
 #include "tinyxml2/tinyxml2.h"
@@ -41,6 +45,14 @@ THE SOFTWARE.
 #endif
 #include <sys/stat.h>
 
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+#include "platform/win32/CCUtils-win32.h"
+#elif (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT)
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 NS_CC_BEGIN
 
 // Implement DictMaker
@@ -325,12 +337,18 @@ public:
 ValueMap FileUtils::getValueMapFromFile(const std::string& filename)
 {
     const std::string fullPath = fullPathForFilename(filename);
-    DictMaker tMaker;
-    return tMaker.dictionaryWithContentsOfFile(fullPath);
+    Data data = getDataFromFile(fullPath);
+    if (data.isNull())
+        return ValueMap();
+
+    return getValueMapFromData(reinterpret_cast<const char*>(data.getBytes()), static_cast<int>(data.getSize()));
 }
 
 ValueMap FileUtils::getValueMapFromData(const char* filedata, int filesize)
 {
+    if (ValueBinary::isValueBinary(filedata, filesize))
+        return ValueBinary::toValueMap(filedata, filesize);
+
     DictMaker tMaker;
     return tMaker.dictionaryWithDataOfFile(filedata, filesize);
 }
@@ -551,6 +569,8 @@ void FileUtils::setDelegate(FileUtils *delegate)
 
 FileUtils::FileUtils()
     : _writablePath("")
+    , _valueMapBinaryCacheEnabled(false)
+    , _fullPathMissCacheSize(0)
 {
 }
 
@@ -584,6 +604,8 @@ bool FileUtils::writeDataToFile(const Data& data, const std::string& fullPath)
     CCASSERT(!fullPath.empty() && data.getSize() != 0, "Invalid parameters.");
 
     auto fileutils = FileUtils::getInstance();
+    // the file may be one which was looked up before it existed
+    fileutils->clearFullPathMissCache();
     do
     {
         // Read the file from hardware
@@ -608,8 +630,81 @@ void FileUtils::writeDataToFile(Data data, const std::string& fullPath, std::fun
     }, std::move(callback), std::move(data));
 }
 
+bool FileUtils::writeValueMapToBinaryFile(const ValueMap& dict, const std::string& fullPath)
+{
+    Data data = ValueBinary::compile(dict);
+    return writeDataToFile(data, fullPath);
+}
+
+Data FileUtils::getValueMapBinaryFromFile(const std::string& filename, ValueMap* fallback)
+{
+    const std::string fullPath = fullPathForFilename(filename);
+    Data data = getDataFromFile(fullPath);
+    if (data.isNull())
+        return Data::Null;
+
+    // Compiled offline, shipped under the plist name
+    if (ValueBinary::isValueBinary(data.getBytes(), data.getSize()))
+        return data;
+
+    const char* source = reinterpret_cast<const char*>(data.getBytes());
+    int sourceSize = static_cast<int>(data.getSize());
+
+    if (!_valueMapBinaryCacheEnabled)
+    {
+        if (fallback)
+            *fallback = getValueMapFromData(source, sourceSize);
+        return Data::Null;
+    }
+
+    // The cache file is named after the path and validated against the content
+    uint32_t sourceHash = XXH32(source, sourceSize, 0);
+    char name[16];
+    snprintf(name, sizeof(name), "%08x.bin", XXH32(fullPath.data(), static_cast<int>(fullPath.size()), 0));
+    const std::string cacheDir = getWritablePath() + "valuemap_cache/";
+    const std::string cachePath = cacheDir + name;
+
+    if (isFileExist(cachePath))
+    {
+        Data cached = getDataFromFile(cachePath);
+        uint32_t cachedHash = 0;
+        uint32_t cachedSize = 0;
+        if (ValueBinary::getSourceInfo(cached.getBytes(), cached.getSize(), &cachedHash, &cachedSize)
+            && cachedHash == sourceHash && cachedSize == static_cast<uint32_t>(sourceSize))
+        {
+            return cached;
+        }
+    }
+
+    ValueMap dict = getValueMapFromData(source, sourceSize);
+    if (dict.empty())
+    {
+        if (fallback)
+            *fallback = std::move(dict);
+        return Data::Null;
+    }
+
+    Data compiled = ValueBinary::compile(dict, sourceHash, static_cast<uint32_t>(sourceSize));
+    if ((!isDirectoryExist(cacheDir) && !createDirectory(cacheDir)) || !writeDataToFile(compiled, cachePath))
+    {
+        CCLOG("cocos2d: FileUtils: failed to write the compiled cache of %s", fullPath.c_str());
+    }
+    return compiled;
+}
+
+void FileUtils::setValueMapBinaryCacheEnabled(bool enabled)
+{
+    _valueMapBinaryCacheEnabled = enabled;
+}
+
+bool FileUtils::isValueMapBinaryCacheEnabled() const
+{
+    return _valueMapBinaryCacheEnabled;
+}
+
 bool FileUtils::init()
 {
+    std::lock_guard<std::recursive_mutex> lock(_searchPathMutex);
     _searchPathArray.push_back(_defaultResRootPath);
     _searchResolutionsOrderArray.push_back("");
     return true;
@@ -617,7 +712,8 @@ bool FileUtils::init()
 
 void FileUtils::purgeCachedEntries()
 {
-    _fullPathCache.clear();
+    clearFullPathCache();
+    clearFullPathMissCache();
 }
 
 std::string FileUtils::getStringFromFile(const std::string& filename)
@@ -652,6 +748,76 @@ void FileUtils::getDataFromFile(const std::string& filename, std::function<void(
     }, std::move(callback));
 }
 
+// Smaller files are read, mapping them costs more than copying them
+static const long MAPPED_DATA_MIN_SIZE = 64 * 1024;
+
+Data FileUtils::getMappedDataFromFile(const std::string& filename)
+{
+    std::string fullPath = fullPathForFilename(filename);
+    if (fullPath.empty())
+        return Data();
+
+    auto packFileMounts = getPackFileMounts();
+    std::string entryName;
+    PackFile* packFile = packFileMounts ? findPackFile(*packFileMounts, fullPath, &entryName) : nullptr;
+    if (packFile)
+        return packFile->getMappedFileData(entryName);
+
+    Data data;
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+    HANDLE file = CreateFileW(StringUtf8ToWideChar(fullPath).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file != INVALID_HANDLE_VALUE)
+    {
+        LARGE_INTEGER size;
+        if (GetFileSizeEx(file, &size) && size.QuadPart >= MAPPED_DATA_MIN_SIZE)
+        {
+            HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping)
+            {
+                void* bytes = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                // the view keeps the mapping object alive
+                CloseHandle(mapping);
+                if (bytes)
+                {
+                    data.fastSetMapped(static_cast<unsigned char*>(bytes), static_cast<ssize_t>(size.QuadPart),
+                                       std::shared_ptr<void>(bytes, [](void* view) { UnmapViewOfFile(view); }));
+                }
+            }
+        }
+        CloseHandle(file);
+    }
+#elif (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT)
+    // apk assets can't be opened, they are read below
+    if (isAbsolutePath(fullPath))
+    {
+        int descriptor = open(getSuitableFOpen(fullPath).c_str(), O_RDONLY);
+        if (descriptor != -1)
+        {
+            struct stat statBuf;
+            if (fstat(descriptor, &statBuf) == 0 && statBuf.st_size >= MAPPED_DATA_MIN_SIZE)
+            {
+                size_t size = statBuf.st_size;
+                void* bytes = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+                if (bytes != MAP_FAILED)
+                {
+                    data.fastSetMapped(static_cast<unsigned char*>(bytes), static_cast<ssize_t>(size),
+                                       std::shared_ptr<void>(bytes, [size](void* address) { munmap(address, size); }));
+                }
+            }
+            // the mapping stays valid after the descriptor is closed
+            close(descriptor);
+        }
+    }
+#endif
+
+    if (data.isNull())
+    {
+        data = getDataFromFile(fullPath);
+    }
+    return data;
+}
+
 FileUtils::Status FileUtils::getContents(const std::string& filename, ResizableBuffer* buffer)
 {
     if (filename.empty())
@@ -663,6 +829,9 @@ FileUtils::Status FileUtils::getContents(const std::string& filename, ResizableB
     if (fullPath.empty())
         return Status::NotExists;
 
+    if (fs->getContentsFromPackFiles(fullPath, buffer))
+        return Status::OK;
+
     FILE *fp = fopen(fs->getSuitableFOpen(fullPath).c_str(), "rb");
     if (!fp)
         return Status::OpenFailed;
@@ -767,6 +936,7 @@ void FileUtils::writeValueVectorToFile(ValueVector vecData, const std::string& f
 
 std::string FileUtils::getNewFilename(const std::string &filename) const
 {
+    std::lock_guard<std::recursive_mutex> lock(_searchPathMutex);
     std::string newFileName;
 
     // in Lookup Filename dictionary ?
@@ -804,6 +974,17 @@ std::string FileUtils::getPathForFilename(const std::string& filename, const std
     return path;
 }
 
+// same layout as getPathForFilename: file_path + resourceDirectory + file
+static std::string getRelativePathForFilename(const std::string& filename, const std::string& resolutionDirectory)
+{
+    size_t pos = filename.find_last_of("/");
+    if (pos != std::string::npos)
+    {
+        return filename.substr(0, pos+1) + resolutionDirectory + filename.substr(pos+1);
+    }
+    return resolutionDirectory + filename;
+}
+
 std::string FileUtils::fullPathForFilename(const std::string &filename) const
 {
     if (filename.empty())
@@ -817,26 +998,60 @@ std::string FileUtils::fullPathForFilename(const std::string &filename) const
     }
 
     // Already Cached ?
-    auto cacheIter = _fullPathCache.find(filename);
-    if(cacheIter != _fullPathCache.end())
     {
-        return cacheIter->second;
+        std::lock_guard<std::mutex> lock(_fullPathCacheMutex);
+        auto cacheIter = _fullPathCache.find(filename);
+        if(cacheIter != _fullPathCache.end())
+        {
+            return cacheIter->second;
+        }
+    }
+
+    // Already missed ? Disabled by default, so most lookups don't take the lock.
+    if (_fullPathMissCacheSize > 0)
+    {
+        std::lock_guard<std::mutex> lock(_fullPathMissCacheMutex);
+        if (_fullPathMissCache.find(filename) != _fullPathMissCache.end())
+        {
+            return "";
+        }
     }
 
+    // the search paths may be changed by the cocos thread while a loading thread searches them
+    std::lock_guard<std::recursive_mutex> lock(_searchPathMutex);
+
     // Get the new file name.
     const std::string newFilename( getNewFilename(filename) );
 
     std::string fullpath;
+    auto packFileMounts = getPackFileMounts();
 
     for (const auto& searchIt : _searchPathArray)
     {
+        auto indexIter = _directoryIndex.find(searchIt);
         for (const auto& resolutionIt : _searchResolutionsOrderArray)
         {
-            fullpath = this->getPathForFilename(newFilename, resolutionIt, searchIt);
+            fullpath.clear();
+            if (packFileMounts)
+            {
+                // mounted entries override the file system
+                std::string path = searchIt + getRelativePathForFilename(newFilename, resolutionIt);
+                if (findPackFile(*packFileMounts, path, nullptr))
+                    fullpath = path;
+            }
+
+            if (fullpath.empty())
+            {
+                if (indexIter != _directoryIndex.end())
+                    fullpath = getPathForFilenameFromIndex(indexIter->second, newFilename, resolutionIt, searchIt);
+                else
+                    fullpath = this->getPathForFilename(newFilename, resolutionIt, searchIt);
+            }
 
             if (!fullpath.empty())
             {
                 // Using the filename passed in as key.
+                std::lock_guard<std::mutex> cacheLock(_fullPathCacheMutex);
                 _fullPathCache.emplace(filename, fullpath);
                 return fullpath;
             }
@@ -844,6 +1059,21 @@ std::string FileUtils::fullPathForFilename(const std::string &filename) const
         }
     }
 
+    if (_fullPathMissCacheSize > 0)
+    {
+        std::lock_guard<std::mutex> cacheLock(_fullPathMissCacheMutex);
+        // read again, it may have been changed before the lock was taken
+        size_t capacity = _fullPathMissCacheSize;
+        if (capacity > 0)
+        {
+            if (_fullPathMissCache.size() >= capacity)
+            {
+                _fullPathMissCache.clear();
+            }
+            _fullPathMissCache.insert(filename);
+        }
+    }
+
     if(isPopupNotify()){
         CCLOG("cocos2d: fullPathForFilename: No file found at %s. Possible missing file.", filename.c_str());
     }
@@ -852,6 +1082,263 @@ std::string FileUtils::fullPathForFilename(const std::string &filename) const
     return "";
 }
 
+std::string FileUtils::getPathForFilenameFromIndex(const std::unordered_set<std::string>& index, const std::string& filename,
+                                                   const std::string& resolutionDirectory, const std::string& searchPath) const
+{
+    // the index holds normalized paths, let the file system resolve the others
+    if (filename.find("./") != std::string::npos || filename.find("//") != std::string::npos)
+    {
+        return getPathForFilename(filename, resolutionDirectory, searchPath);
+    }
+
+    std::string relativePath = getRelativePathForFilename(filename, resolutionDirectory);
+    if (index.find(relativePath) == index.end())
+    {
+        return "";
+    }
+    return searchPath + relativePath;
+}
+
+std::string FileUtils::normalizeSearchPath(const std::string& searchPath) const
+{
+    // same as addSearchPath
+    std::string path = searchPath;
+    if (!isAbsolutePath(searchPath))
+        path = _defaultResRootPath + searchPath;
+
+    if (!path.empty() && path[path.length()-1] != '/')
+    {
+        path += "/";
+    }
+    return path;
+}
+
+bool FileUtils::addDirectoryIndex(const std::string& searchPath)
+{
+    const std::string root = normalizeSearchPath(searchPath);
+
+    std::vector<std::string> files;
+    if (isDirectoryExist(root))
+    {
+        listFilesRecursively(root, &files);
+    }
+    if (files.empty())
+    {
+        CCLOG("cocos2d: addDirectoryIndex: can't list %s", root.c_str());
+        return false;
+    }
+
+    std::unordered_set<std::string> index;
+    index.reserve(files.size());
+    for (const auto& file : files)
+    {
+        // listed paths are the directory path, maybe followed by a doubled separator, and the name
+        if (file.compare(0, root.length() - 1, root, 0, root.length() - 1) != 0)
+            continue;
+        size_t start = root.length() - 1;
+        while (start < file.length() && file[start] == '/')
+            ++start;
+        if (start < file.length() && file[file.length()-1] != '/')
+            index.insert(file.substr(start));
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(_searchPathMutex);
+    _directoryIndex[root] = std::move(index);
+    clearFullPathMissCache();
+    return true;
+}
+
+bool FileUtils::addDirectoryIndexFromFile(const std::string& searchPath, const std::string& manifestFile)
+{
+    std::string manifest = getStringFromFile(manifestFile);
+    if (manifest.empty())
+    {
+        CCLOG("cocos2d: addDirectoryIndexFromFile: can't read %s", manifestFile.c_str());
+        return false;
+    }
+
+    std::unordered_set<std::string> index;
+    size_t start = 0;
+    while (start < manifest.length())
+    {
+        size_t end = manifest.find('\n', start);
+        if (end == std::string::npos)
+            end = manifest.length();
+        size_t length = end - start;
+        if (length > 0 && manifest[end-1] == '\r')
+            --length;
+        if (length > 0)
+            index.emplace(manifest, start, length);
+        start = end + 1;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(_searchPathMutex);
+    _directoryIndex[normalizeSearchPath(searchPath)] = std::move(index);
+    clearFullPathMissCache();
+    return true;
+}
+
+bool FileUtils::writeDirectoryIndexToFile(const std::string& searchPath, const std::string& fullPath) const
+{
+    std::lock_guard<std::recursive_mutex> lock(_searchPathMutex);
+    auto iter = _directoryIndex.find(normalizeSearchPath(searchPath));
+    if (iter == _directoryIndex.end())
+    {
+        return false;
+    }
+
+    std::vector<std::string> files(iter->second.begin(), iter->second.end());
+    std::sort(files.begin(), files.end());
+
+    std::string manifest;
+    for (const auto& file : files)
+    {
+        manifest += file;
+        manifest += '\n';
+    }
+    return FileUtils::getInstance()->writeStringToFile(manifest, fullPath);
+}
+
+void FileUtils::removeDirectoryIndex(const std::string& searchPath)
+{
+    std::lock_guard<std::recursive_mutex> lock(_searchPathMutex);
+    _directoryIndex.erase(normalizeSearchPath(searchPath));
+    clearFullPathMissCache();
+}
+
+void FileUtils::setFullPathMissCacheSize(size_t size)
+{
+    std::lock_guard<std::mutex> lock(_fullPathMissCacheMutex);
+    _fullPathMissCacheSize = size;
+    _fullPathMissCache.clear();
+}
+
+size_t FileUtils::getFullPathMissCacheSize() const
+{
+    return _fullPathMissCacheSize;
+}
+
+std::unordered_map<std::string, std::string> FileUtils::getFullPathCache() const
+{
+    std::lock_guard<std::mutex> lock(_fullPathCacheMutex);
+    return _fullPathCache;
+}
+
+void FileUtils::clearFullPathCache()
+{
+    std::lock_guard<std::mutex> lock(_fullPathCacheMutex);
+    _fullPathCache.clear();
+}
+
+void FileUtils::clearFullPathMissCache()
+{
+    // it stays empty while disabled
+    if (_fullPathMissCacheSize == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(_fullPathMissCacheMutex);
+    _fullPathMissCache.clear();
+}
+
+bool FileUtils::mountPackFile(const std::string& packFile, const std::string& mountPoint, bool front)
+{
+    std::string fullPath = fullPathForFilename(packFile);
+    if (fullPath.empty())
+    {
+        CCLOG("cocos2d: mountPackFile: can't find %s", packFile.c_str());
+        return false;
+    }
+
+    std::shared_ptr<PackFile> archive(PackFile::create(fullPath));
+    if (!archive)
+    {
+        return false;
+    }
+
+    PackFileMount mount;
+    mount.mountPoint = normalizeSearchPath(mountPoint);
+    mount.packFile = archive;
+
+    {
+        std::lock_guard<std::mutex> lock(_packFileMountsMutex);
+        auto mounts = _packFileMounts ? std::make_shared<PackFileMounts>(*_packFileMounts) : std::make_shared<PackFileMounts>();
+        if (front)
+            mounts->insert(mounts->begin(), std::move(mount));
+        else
+            mounts->push_back(std::move(mount));
+        _packFileMounts = mounts;
+    }
+
+    // the entries may override files found before
+    clearFullPathCache();
+    clearFullPathMissCache();
+    return true;
+}
+
+bool FileUtils::unmountPackFile(const std::string& packFile)
+{
+    std::string fullPath = fullPathForFilename(packFile);
+
+    bool found = false;
+    {
+        std::lock_guard<std::mutex> lock(_packFileMountsMutex);
+        if (!_packFileMounts)
+            return false;
+
+        auto mounts = std::make_shared<PackFileMounts>();
+        for (const auto& mount : *_packFileMounts)
+        {
+            if (mount.packFile->getPath() == fullPath)
+                found = true;
+            else
+                mounts->push_back(mount);
+        }
+        if (!found)
+            return false;
+        _packFileMounts = mounts->empty() ? nullptr : mounts;
+    }
+
+    clearFullPathCache();
+    clearFullPathMissCache();
+    return true;
+}
+
+std::shared_ptr<const FileUtils::PackFileMounts> FileUtils::getPackFileMounts() const
+{
+    std::lock_guard<std::mutex> lock(_packFileMountsMutex);
+    return _packFileMounts;
+}
+
+PackFile* FileUtils::findPackFile(const PackFileMounts& mounts, const std::string& fullPath, std::string* name)
+{
+    for (const auto& mount : mounts)
+    {
+        const std::string& mountPoint = mount.mountPoint;
+        if (fullPath.length() > mountPoint.length() && fullPath.compare(0, mountPoint.length(), mountPoint) == 0)
+        {
+            std::string entryName = fullPath.substr(mountPoint.length());
+            if (mount.packFile->fileExists(entryName))
+            {
+                if (name)
+                    *name = std::move(entryName);
+                return mount.packFile.get();
+            }
+        }
+    }
+    return nullptr;
+}
+
+bool FileUtils::getContentsFromPackFiles(const std::string& fullPath, ResizableBuffer* buffer) const
+{
+    auto packFileMounts = getPackFileMounts();
+    if (!packFileMounts)
+        return false;
+
+    std::string entryName;
+    PackFile* packFile = findPackFile(*packFileMounts, fullPath, &entryName);
+    return packFile && packFile->getFileData(entryName, buffer);
+}
+
 std::string FileUtils::fullPathFromRelativeFile(const std::string &filename, const std::string &relativeFile)
 {
     return relativeFile.substr(0, relativeFile.rfind('/')+1) + getNewFilename(filename);
@@ -859,6 +1346,7 @@ std::string FileUtils::fullPathFromRelativeFile(const std::string &filename, con
 
 void FileUtils::setSearchResolutionsOrder(const std::vector<std::string>& searchResolutionsOrder)
 {
+    std::lock_guard<std::recursive_mutex> lock(_searchPathMutex);
     if (_searchResolutionsOrderArray == searchResolutionsOrder)
     {
         return;
@@ -866,7 +1354,8 @@ void FileUtils::setSearchResolutionsOrder(const std::vector<std::string>& search
 
     bool existDefault = false;
 
-    _fullPathCache.clear();
+    clearFullPathCache();
+    clearFullPathMissCache();
     _searchResolutionsOrderArray.clear();
     for(const auto& iter : searchResolutionsOrder)
     {
@@ -892,10 +1381,13 @@ void FileUtils::setSearchResolutionsOrder(const std::vector<std::string>& search
 
 void FileUtils::addSearchResolutionsOrder(const std::string &order,const bool front)
 {
+    std::lock_guard<std::recursive_mutex> lock(_searchPathMutex);
     std::string resOrder = order;
     if (!resOrder.empty() && resOrder[resOrder.length()-1] != '/')
         resOrder.append("/");
 
+    clearFullPathMissCache();
+
     if (front) {
         _searchResolutionsOrderArray.insert(_searchResolutionsOrderArray.begin(), resOrder);
     } else {
@@ -930,9 +1422,11 @@ const std::string& FileUtils::getDefaultResourceRootPath() const
 
 void FileUtils::setDefaultResourceRootPath(const std::string& path)
 {
+    std::lock_guard<std::recursive_mutex> lock(_searchPathMutex);
     if (_defaultResRootPath != path)
     {
-        _fullPathCache.clear();
+        clearFullPathCache();
+        clearFullPathMissCache();
         _defaultResRootPath = path;
         if (!_defaultResRootPath.empty() && _defaultResRootPath[_defaultResRootPath.length()-1] != '/')
         {
@@ -946,10 +1440,12 @@ void FileUtils::setDefaultResourceRootPath(const std::string& path)
 
 void FileUtils::setSearchPaths(const std::vector<std::string>& searchPaths)
 {
+    std::lock_guard<std::recursive_mutex> lock(_searchPathMutex);
     bool existDefaultRootPath = false;
     _originalSearchPaths = searchPaths;
 
-    _fullPathCache.clear();
+    clearFullPathCache();
+    clearFullPathMissCache();
     _searchPathArray.clear();
 
     for (const auto& path : _originalSearchPaths)
@@ -982,6 +1478,7 @@ void FileUtils::setSearchPaths(const std::vector<std::string>& searchPaths)
 
 void FileUtils::addSearchPath(const std::string &searchpath,const bool front)
 {
+    std::lock_guard<std::recursive_mutex> lock(_searchPathMutex);
     std::string prefix;
     if (!isAbsolutePath(searchpath))
         prefix = _defaultResRootPath;
@@ -992,6 +1489,8 @@ void FileUtils::addSearchPath(const std::string &searchpath,const bool front)
         path += "/";
     }
 
+    clearFullPathMissCache();
+
     if (front) {
         _originalSearchPaths.insert(_originalSearchPaths.begin(), searchpath);
         _searchPathArray.insert(_searchPathArray.begin(), path);
@@ -1011,7 +1510,9 @@ void FileUtils::addSearchPath(const std::string &searchpath,const bool front)
 
 void FileUtils::setFilenameLookupDictionary(const ValueMap& filenameLookupDict)
 {
-    _fullPathCache.clear();
+    std::lock_guard<std::recursive_mutex> lock(_searchPathMutex);
+    clearFullPathCache();
+    clearFullPathMissCache();
     _filenameLookupDict = filenameLookupDict;
 }
 
@@ -1055,6 +1556,9 @@ bool FileUtils::isFileExist(const std::string& filename) const
 {
     if (isAbsolutePath(filename))
     {
+        auto packFileMounts = getPackFileMounts();
+        if (packFileMounts && findPackFile(*packFileMounts, filename, nullptr))
+            return true;
         return isFileExistInternal(filename);
     }
     else
@@ -1090,12 +1594,19 @@ bool FileUtils::isDirectoryExist(const std::string& dirPath) const
     }
 
     // Already Cached ?
-    auto cacheIter = _fullPathCache.find(dirPath);
-    if( cacheIter != _fullPathCache.end() )
+    std::string cachedPath;
+    {
+        std::lock_guard<std::mutex> lock(_fullPathCacheMutex);
+        auto cacheIter = _fullPathCache.find(dirPath);
+        if( cacheIter != _fullPathCache.end() )
+            cachedPath = cacheIter->second;
+    }
+    if (!cachedPath.empty())
     {
-        return isDirectoryExistInternal(cacheIter->second);
+        return isDirectoryExistInternal(cachedPath);
     }
 
+    std::lock_guard<std::recursive_mutex> lock(_searchPathMutex);
     std::string fullpath;
     for (const auto& searchIt : _searchPathArray)
     {
@@ -1105,6 +1616,7 @@ bool FileUtils::isDirectoryExist(const std::string& dirPath) const
             fullpath = fullPathForFilename(searchIt + dirPath + resolutionIt);
             if (isDirectoryExistInternal(fullpath))
             {
+                std::lock_guard<std::mutex> cacheLock(_fullPathCacheMutex);
                 _fullPathCache.emplace(dirPath, fullpath);
                 return true;
             }
@@ -28,6 +28,10 @@ THE SOFTWARE.
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
+#include <mutex>
+#include <atomic>
+#include <memory>
 #include <type_traits>
 
 #include "platform/CCPlatformMacros.h"
@@ -116,6 +120,8 @@ public:
 };
 
 /** Helper class to handle file operations. */
+class PackFile;
+
 class CC_DLL FileUtils
 {
 public:
@@ -192,6 +198,18 @@ public:
      */
     virtual void getDataFromFile(const std::string& filename, std::function<void(Data)> callback);
 
+    /**
+     *  Gets the contents of a file as a read-only memory mapping, so large assets which are
+     *  parsed once aren't copied to the heap, and the page cache is shared between loads.
+     *  The bytes of the returned Data must not be modified. Small files and files which
+     *  can't be mapped, like apk assets, are read with getDataFromFile. Entries of mounted
+     *  pack files share the archive's mapping. Loaders which decrypt or decode their input
+     *  in place must copy it first, or use getDataFromFile, which always returns a private copy.
+     *  @see Data::isMapped
+     *  @since v3.17
+     */
+    virtual Data getMappedDataFromFile(const std::string& filename);
+
     enum class Status
     {
         OK = 0,
@@ -459,6 +477,84 @@ public:
       */
     void addSearchPath(const std::string & path, const bool front=false);
 
+    /**
+     * Indexes the files under a search path, so fullPathForFilename answers lookups in it
+     * from memory instead of checking each candidate path on the file system.
+     * The directory is listed once. Only index search paths which don't change: files
+     * created under an indexed search path later aren't found.
+     *
+     * @param searchPath A search path, relative to the default resource root path or absolute,
+     *                   as passed to addSearchPath.
+     * @return False if the directory can't be listed, e.g. apk assets on Android;
+     *         use addDirectoryIndexFromFile there.
+     * @since v3.17
+     */
+    virtual bool addDirectoryIndex(const std::string& searchPath);
+
+    /**
+     * Same as addDirectoryIndex, but reads the index from a manifest file listing the
+     * paths of the files relative to the search path, one per line.
+     * @see writeDirectoryIndexToFile
+     * @since v3.17
+     */
+    virtual bool addDirectoryIndexFromFile(const std::string& searchPath, const std::string& manifestFile);
+
+    /**
+     * Writes the index of an indexed search path as a manifest for addDirectoryIndexFromFile.
+     * @since v3.17
+     */
+    virtual bool writeDirectoryIndexToFile(const std::string& searchPath, const std::string& fullPath) const;
+
+    /**
+     * Removes the index of a search path.
+     * @since v3.17
+     */
+    virtual void removeDirectoryIndex(const std::string& searchPath);
+
+    /**
+     * Sets how many filenames which weren't found in the search paths are remembered,
+     * so looking them up again doesn't touch the file system. The cache is cleared when
+     * the search paths, the resolution orders or the filename lookup dictionary change,
+     * by purgeCachedEntries and when a file is written with writeDataToFile.
+     * Files created by other means under a search path, like renameFile, unzipping or
+     * downloads, keep resolving as missing until purgeCachedEntries is called, so the
+     * cache is only worth enabling when the searched files don't change at runtime.
+     * 0 disables the cache. Defaults to the "cocos2d.x.fileutils.miss_cache_size"
+     * configuration value, or 0.
+     * @since v3.17
+     */
+    void setFullPathMissCacheSize(size_t size);
+
+    /** @since v3.17 */
+    size_t getFullPathMissCacheSize() const;
+
+    /**
+     * Mounts a zip file or a pack file written by PackFile::createFromDirectory, so its
+     * entries are found and read like files under the mount point. A mounted entry
+     * overrides a file at the same path on the file system.
+     *
+     * Thousands of small files load faster from one pack file: it is opened once,
+     * lookups use its index, and the entries of a pack file are read in place
+     * from the mapped file.
+     *
+     * @param packFile The archive, found through the search paths.
+     * @param mountPoint The directory the entries appear in, relative to the default resource
+     *                   root path or absolute, as passed to addSearchPath. Defaults to the
+     *                   default resource root path.
+     * @param front If true, the archive overrides the entries of the archives mounted before,
+     *              which is what hot-fix patches need. Otherwise they override it.
+     * @return False if the archive can't be read.
+     * @note Mounted entries aren't listed by listFiles and don't make isDirectoryExist return true.
+     * @since v3.17
+     */
+    bool mountPackFile(const std::string& packFile, const std::string& mountPoint = "", bool front = true);
+
+    /**
+     * Unmounts an archive mounted by mountPackFile.
+     * @since v3.17
+     */
+    bool unmountPackFile(const std::string& packFile);
+
     /**
      *  Gets the array of search paths.
      *
@@ -512,6 +608,43 @@ public:
      */
     virtual ValueMap getValueMapFromData(const char* filedata, int filesize);
 
+    /**
+     * Gets the contents of a ValueMap file in the compiled binary form read by ValueBinary.
+     *
+     * Files compiled with writeValueMapToBinaryFile are returned as they are. Other files
+     * are compiled to the writable path on first use when the cache is enabled, and read
+     * from there afterwards while the source file is unchanged.
+     *
+     * @param filename The plist or compiled file.
+     * @param fallback If not null, filled with the parsed file when null Data is returned,
+     * so the file doesn't have to be read again.
+     * @return The compiled data, or null Data if the cache is disabled or the file can't be read.
+     * @since v3.17
+     */
+    virtual Data getValueMapBinaryFromFile(const std::string& filename, ValueMap* fallback = nullptr);
+
+    /**
+     * Compiles a ValueMap into a binary file, see ValueBinary.
+     * The file can replace a plist under the same name and is read back by
+     * getValueMapFromFile and getValueMapBinaryFromFile without XML parsing.
+     *
+     * @param dict The ValueMap to compile.
+     * @param fullPath The full path of the file to write.
+     * @return True if the file was written.
+     * @since v3.17
+     */
+    virtual bool writeValueMapToBinaryFile(const ValueMap& dict, const std::string& fullPath);
+
+    /**
+     * Enables compiling plist files to the writable path in getValueMapBinaryFromFile.
+     * Defaults to the "cocos2d.x.valuemap_binary_cache" configuration value, or false.
+     * @since v3.17
+     */
+    void setValueMapBinaryCacheEnabled(bool enabled);
+
+    /** @since v3.17 */
+    bool isValueMapBinaryCacheEnabled() const;
+
     /**
     * write a ValueMap into a plist file
     *
@@ -840,7 +973,7 @@ public:
     virtual void listFilesRecursivelyAsync(const std::string& dirPath, std::function<void(std::vector<std::string>)> callback) const;
 
     /** Returns the full path cache. */
-    const std::unordered_map<std::string, std::string>& getFullPathCache() const { return _fullPathCache; }
+    std::unordered_map<std::string, std::string> getFullPathCache() const;
 
     /**
      *  Gets the new filename from the filename lookup dictionary.
@@ -891,6 +1024,45 @@ protected:
      */
     virtual std::string getPathForFilename(const std::string& filename, const std::string& resolutionDirectory, const std::string& searchPath) const;
 
+    /**
+     *  Same as getPathForFilename, for a search path indexed by addDirectoryIndex.
+     *  @since v3.17
+     */
+    std::string getPathForFilenameFromIndex(const std::unordered_set<std::string>& index, const std::string& filename,
+                                            const std::string& resolutionDirectory, const std::string& searchPath) const;
+
+    /** Returns the search path in the form stored in _searchPathArray. */
+    std::string normalizeSearchPath(const std::string& searchPath) const;
+
+    void clearFullPathCache();
+    void clearFullPathMissCache();
+
+    struct PackFileMount
+    {
+        std::string mountPoint;
+        std::shared_ptr<PackFile> packFile;
+    };
+    typedef std::vector<PackFileMount> PackFileMounts;
+
+    /** Returns the mounted archives, or nullptr if there are none. */
+    std::shared_ptr<const PackFileMounts> getPackFileMounts() const;
+
+    /**
+     *  Finds the mounted archive containing a file.
+     *  @param fullPath The full path of the file.
+     *  @param name If not nullptr, set to the name of the entry.
+     *  @return The archive, or nullptr.
+     */
+    static PackFile* findPackFile(const PackFileMounts& mounts, const std::string& fullPath, std::string* name);
+
+    /**
+     *  Reads a file from the mounted archives.
+     *  Platform implementations of getContents call it before reading the file system.
+     *  @return False if no mounted archive contains the file.
+     *  @since v3.17
+     */
+    bool getContentsFromPackFiles(const std::string& fullPath, ResizableBuffer* buffer) const;
+
     /**
      *  Gets full path for the directory and the filename.
      *
@@ -943,12 +1115,42 @@ protected:
      *  This variable is used for improving the performance of file search.
      */
     mutable std::unordered_map<std::string, std::string> _fullPathCache;
+    /** Guards _fullPathCache, the texture loading threads resolve paths concurrently. */
+    mutable std::mutex _fullPathCacheMutex;
+    /** Guards the search paths, the resolution orders, the filename lookup dictionary and the
+     *  directory indexes while they are searched or changed, the texture loading threads
+     *  resolve paths concurrently. Recursive because platform lookups may call back into FileUtils.
+     */
+    mutable std::recursive_mutex _searchPathMutex;
 
     /**
      * Writable path.
      */
     std::string _writablePath;
 
+    /** Whether getValueMapBinaryFromFile compiles plist files to the writable path. */
+    bool _valueMapBinaryCacheEnabled;
+
+    /**
+     * Paths of the files under indexed search paths, relative to the search path.
+     * Keyed by search path, in the form stored in _searchPathArray.
+     */
+    std::unordered_map<std::string, std::unordered_set<std::string>> _directoryIndex;
+
+    /** Filenames which weren't found by fullPathForFilename. */
+    mutable std::unordered_set<std::string> _fullPathMissCache;
+    /** Guards the cache, writeDataToFile may clear it from another thread. */
+    mutable std::mutex _fullPathMissCacheMutex;
+    /** Atomic, so the lookups skip the lock while the cache is disabled. */
+    std::atomic<size_t> _fullPathMissCacheSize;
+
+    /**
+     * Mounted archives, the first one overrides the others. The list is replaced when an
+     * archive is mounted, so loading threads can keep using the one they got.
+     */
+    std::shared_ptr<const PackFileMounts> _packFileMounts;
+    mutable std::mutex _packFileMountsMutex;
+
     /**
      *  The singleton pointer of FileUtils.
      */
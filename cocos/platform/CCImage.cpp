@@ -451,6 +451,30 @@ namespace
         }
     }
 #endif //CC_USE_PNG
+
+    // Reads an image file through a read-only mapping when possible. Encrypted files
+    // are decrypted in place by initWithImageData, so they get a private copy.
+    Data getImageDataFromFile(const std::string& fullPath)
+    {
+        Data data = FileUtils::getInstance()->getMappedDataFromFile(fullPath);
+        if (data.isMapped())
+        {
+            bool decodedInPlace = data.getSize() >= 4 && memcmp(data.getBytes(), "CCZp", 4) == 0;
+            NSwfHeader nswfHeader;
+            if (data.getSize() >= (ssize_t)sizeof(nswfHeader))
+            {
+                memcpy(&nswfHeader, data.getBytes(), sizeof(nswfHeader));
+                decodedInPlace = decodedInPlace || nswfHeader.isSigned();
+            }
+            if (decodedInPlace)
+            {
+                Data copy;
+                copy.copy(data.getBytes(), data.getSize());
+                return copy;
+            }
+        }
+        return data;
+    }
 }
 
 Texture2D::PixelFormat getDevicePixelFormat(Texture2D::PixelFormat format)
@@ -603,7 +627,7 @@ bool Image::initWithImageFile(const std::string& path)
     bool ret = false;
     _filePath = FileUtils::getInstance()->fullPathForFilename(path);
 
-    Data data = FileUtils::getInstance()->getDataFromFile(_filePath);
+    Data data = getImageDataFromFile(_filePath);
 
     if (!data.isNull())
     {
@@ -618,7 +642,7 @@ bool Image::initWithImageFileThreadSafe(const std::string& fullpath)
     bool ret = false;
     _filePath = fullpath;
 
-    Data data = FileUtils::getInstance()->getDataFromFile(fullpath);
+    Data data = getImageDataFromFile(fullpath);
 
     if (!data.isNull())
     {
@@ -292,6 +292,9 @@ FileUtils::Status FileUtilsAndroid::getContents(const std::string& filename, Res
     if (fullPath[0] == '/')
         return FileUtils::getContents(fullPath, buffer);
 
+    if (getContentsFromPackFiles(fullPath, buffer))
+        return FileUtils::Status::OK;
+
     string relativePath = string();
     size_t position = fullPath.find(apkprefix);
     if (0 == position) {
@@ -65,6 +65,15 @@ extern PFNGLDELETEVERTEXARRAYSOESPROC glDeleteVertexArraysOESEXT;
 #define glBindVertexArrayOES glBindVertexArrayOESEXT
 #define glDeleteVertexArraysOES glDeleteVertexArraysOESEXT
 
+// GL_OES_get_program_binary, used by the GLProgramCache binary cache
+extern PFNGLGETPROGRAMBINARYOESPROC glGetProgramBinaryOESEXT;
+extern PFNGLPROGRAMBINARYOESPROC glProgramBinaryOESEXT;
+
+#define glGetProgramBinary                  glGetProgramBinaryOESEXT
+#define glProgramBinary                     glProgramBinaryOESEXT
+#define GL_PROGRAM_BINARY_LENGTH            GL_PROGRAM_BINARY_LENGTH_OES
+#define GL_NUM_PROGRAM_BINARY_FORMATS       GL_NUM_PROGRAM_BINARY_FORMATS_OES
+
 
 #endif // CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
 
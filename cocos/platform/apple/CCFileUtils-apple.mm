@@ -35,6 +35,7 @@ THE SOFTWARE.
 #include "base/CCDirector.h"
 #include "platform/CCFileUtils.h"
 #include "platform/CCSAXParser.h"
+#include "base/CCValueBinary.h"
 
 NS_CC_BEGIN
 
@@ -340,6 +341,9 @@ ValueMap FileUtilsApple::getValueMapFromFile(const std::string& filename)
 
 ValueMap FileUtilsApple::getValueMapFromData(const char* filedata, int filesize)
 {
+    if (ValueBinary::isValueBinary(filedata, filesize))
+        return ValueBinary::toValueMap(filedata, filesize);
+
     NSData* file = [NSData dataWithBytes:filedata length:filesize];
     NSPropertyListFormat format;
     NSError* error;
@@ -171,6 +171,9 @@ FileUtils::Status FileUtilsWin32::getContents(const std::string& filename, Resiz
     // read the file from hardware
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(filename);
 
+    if (getContentsFromPackFiles(fullPath, buffer))
+        return FileUtils::Status::OK;
+
     HANDLE fileHandle = ::CreateFile(StringUtf8ToWideChar(fullPath).c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, NULL, nullptr);
     if (fileHandle == INVALID_HANDLE_VALUE)
         return FileUtils::Status::OpenFailed;
@@ -365,15 +368,8 @@ bool FileUtilsWin32::renameFile(const std::string &oldfullpath, const std::strin
     std::wstring _wNew = StringUtf8ToWideChar(newfullpath);
     std::wstring _wOld = StringUtf8ToWideChar(oldfullpath);
 
-    if (FileUtils::getInstance()->isFileExist(newfullpath))
-    {
-        if (!DeleteFile(_wNew.c_str()))
-        {
-            CCLOGERROR("Fail to delete file %s !Error code is 0x%x", newfullpath.c_str(), GetLastError());
-        }
-    }
-
-    if (MoveFile(_wOld.c_str(), _wNew.c_str()))
+    // replaces an existing file in one step, UserDefault relies on it to never lose its file
+    if (MoveFileExW(_wOld.c_str(), _wNew.c_str(), MOVEFILE_REPLACE_EXISTING))
     {
         return true;
     }
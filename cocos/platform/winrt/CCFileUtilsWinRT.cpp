@@ -151,6 +151,9 @@ FileUtils::Status CCFileUtilsWinRT::getContents(const std::string& filename, Res
     // read the file from hardware
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(filename);
 
+    if (getContentsFromPackFiles(fullPath, buffer))
+        return FileUtils::Status::OK;
+
     HANDLE fileHandle = ::CreateFile2(StringUtf8ToWideChar(fullPath).c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, OPEN_EXISTING, nullptr);
     if (fileHandle == INVALID_HANDLE_VALUE)
         return FileUtils::Status::OpenFailed;
@@ -342,16 +345,9 @@ bool CCFileUtilsWinRT::renameFile(const std::string &oldfullpath, const std::str
 
     std::wstring _wNewfullpath = StringUtf8ToWideChar(_newfullpath);
 
-    if (FileUtils::getInstance()->isFileExist(_newfullpath))
-    {
-        if (!DeleteFile(_wNewfullpath.c_str()))
-        {
-            CCLOGERROR("Fail to delete file %s !Error code is 0x%x", newfullpath.c_str(), GetLastError());
-        }
-    }
-
+    // replaces an existing file in one step, UserDefault relies on it to never lose its file
     if (MoveFileEx(StringUtf8ToWideChar(_oldfullpath).c_str(), _wNewfullpath.c_str(),
-        MOVEFILE_REPLACE_EXISTING & MOVEFILE_WRITE_THROUGH))
+        MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
     {
         return true;
     }
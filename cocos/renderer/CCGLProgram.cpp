@@ -28,11 +28,15 @@ THE SOFTWARE.
 
 #include "renderer/CCGLProgram.h"
 
+#include <climits>
+
 #ifndef WIN32
 #include <alloca.h>
 #endif
 
 #include "base/CCDirector.h"
+#include "base/CCConfiguration.h"
+#include "base/CCData.h"
 #include "base/ccUTF8.h"
 #include "renderer/ccGLStateCache.h"
 #include "platform/CCFileUtils.h"
@@ -217,7 +221,10 @@ GLProgram::GLProgram()
 : _program(0)
 , _vertShader(0)
 , _fragShader(0)
+, _binaryRetrievable(false)
 , _flags()
+, _builtInTimeFrame(UINT_MAX)
+, _userUniformsOwner(nullptr)
 {
     _director = Director::getInstance();
     CCASSERT(nullptr != _director, "Director is null when init a GLProgram");
@@ -602,6 +609,13 @@ bool GLProgram::link()
 
     bindPredefinedVertexAttribs();
 
+#if CC_USE_GL_PROGRAM_BINARY_CACHE && defined(CC_PLATFORM_PC)
+    if (_binaryRetrievable && Configuration::getInstance()->supportsProgramBinary())
+    {
+        glProgramParameteri(_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+#endif
+
     glLinkProgram(_program);
 
     // Calling glGetProgramiv(...GL_LINK_STATUS...) will force linking of the program at this moment.
@@ -628,6 +642,83 @@ bool GLProgram::link()
     return (status == GL_TRUE);
 }
 
+bool GLProgram::initWithProgramBinary(GLenum binaryFormat, const void* binary, GLsizei length)
+{
+#if CC_USE_GL_PROGRAM_BINARY_CACHE
+    if (!Configuration::getInstance()->supportsProgramBinary() || binary == nullptr || length <= 0)
+    {
+        return false;
+    }
+
+    _program = glCreateProgram();
+    _vertShader = _fragShader = 0;
+    clearHashUniforms();
+
+    glProgramBinary(_program, binaryFormat, binary, length);
+
+    GLint status = GL_FALSE;
+    glGetProgramiv(_program, GL_LINK_STATUS, &status);
+    // a rejected binary raises GL_INVALID_ENUM or GL_INVALID_VALUE, it isn't an error for the caller
+    glGetError();
+
+    if (status == GL_FALSE)
+    {
+        CCLOG("cocos2d: program binary rejected by the driver: %i", _program);
+        GL::deleteProgram(_program);
+        _program = 0;
+        return false;
+    }
+
+    parseVertexAttribs();
+    parseUniforms();
+
+    return true;
+#else
+    CC_UNUSED_PARAM(binaryFormat);
+    CC_UNUSED_PARAM(binary);
+    CC_UNUSED_PARAM(length);
+    return false;
+#endif
+}
+
+bool GLProgram::getProgramBinary(GLenum* binaryFormat, Data* binary) const
+{
+#if CC_USE_GL_PROGRAM_BINARY_CACHE
+    if (_program == 0 || !Configuration::getInstance()->supportsProgramBinary())
+    {
+        return false;
+    }
+
+    GLint length = 0;
+    glGetProgramiv(_program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+    {
+        return false;
+    }
+
+    auto bytes = (unsigned char*)malloc(length);
+    if (bytes == nullptr)
+    {
+        return false;
+    }
+
+    GLsizei written = 0;
+    glGetProgramBinary(_program, length, &written, binaryFormat, bytes);
+    if (written <= 0)
+    {
+        free(bytes);
+        return false;
+    }
+
+    binary->fastSet(bytes, written);
+    return true;
+#else
+    CC_UNUSED_PARAM(binaryFormat);
+    CC_UNUSED_PARAM(binary);
+    return false;
+#endif
+}
+
 void GLProgram::use()
 {
     GL::useProgram(_program);
@@ -717,6 +808,12 @@ bool GLProgram::updateUniformLocation(GLint location, const GLvoid* data, unsign
         }
     }
 
+    // a user uniform was changed, maybe outside of the GLProgramState which sent the others
+    if (updated && _userUniformsOwner && !isBuiltInUniformLocation(location))
+    {
+        _userUniformsOwner = nullptr;
+    }
+
     return updated;
 }
 
@@ -968,7 +1065,10 @@ void GLProgram::setUniformsForBuiltins(const Mat4 &matrixMV)
         setUniformLocationWithMatrix3fv(_builtInUniforms[UNIFORM_NORMAL_MATRIX], normalMat, 1);
     }
 
-    if (_flags.usesTime) {
+    // the time is shared by all the draws of a frame, send it once per frame
+    if (_flags.usesTime && _builtInTimeFrame != _director->getTotalFrames()) {
+        _builtInTimeFrame = _director->getTotalFrames();
+
         // This doesn't give the most accurate global time value.
         // Cocos2D doesn't store a high precision time value, so this will have to do.
         // Getting Mach time per frame per shader using time could be extremely expensive.
@@ -987,6 +1087,8 @@ void GLProgram::reset()
 {
     _vertShader = _fragShader = 0;
     memset(_builtInUniforms, 0, sizeof(_builtInUniforms));
+    _builtInTimeFrame = UINT_MAX;
+    _userUniformsOwner = nullptr;
 
 
     // it is already deallocated by android
@@ -1011,6 +1113,18 @@ inline void GLProgram::clearShader()
     _vertShader = _fragShader = 0;
 }
 
+bool GLProgram::isBuiltInUniformLocation(GLint location) const
+{
+    for (int i = 0; i < UNIFORM_MAX; ++i)
+    {
+        if (_builtInUniforms[i] == location)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 inline void GLProgram::clearHashUniforms()
 {
     for (auto e: _hashForUniforms)
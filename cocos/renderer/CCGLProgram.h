@@ -48,6 +48,7 @@ NS_CC_BEGIN
 
 class GLProgram;
 class Director;
+class Data;
 //FIXME: these two typedefs would be deprecated or removed in version 4.0.
 typedef void (*GLInfoFunction)(GLuint program, GLenum pname, GLint* params);
 typedef void (*GLLogFunction) (GLuint program, GLsizei bufsize, GLsizei* length, GLchar* infolog);
@@ -422,6 +423,34 @@ public:
 
     /** links the glProgram */
     bool link();
+
+    /**
+     Initializes the GLProgram with a program binary returned by getProgramBinary(), instead of compiling and linking shaders.
+     The program is ready to use, don't call link(), but call updateUniforms() as usual.
+     It fails when the driver rejects the binary, e.g. after a driver update, so keep the sources to compile them instead.
+     It always fails if Configuration::supportsProgramBinary() is false.
+     * @js NA
+     * @lua NA
+     * @since v3.17
+     */
+    bool initWithProgramBinary(GLenum binaryFormat, const void* binary, GLsizei length);
+
+    /**
+     Gets the binary of the linked program, to be loaded back by initWithProgramBinary().
+     Call setProgramBinaryRetrievable(true) before link(), some drivers return nothing otherwise.
+     @return false if the binary can't be retrieved.
+     * @js NA
+     * @lua NA
+     * @since v3.17
+     */
+    bool getProgramBinary(GLenum* binaryFormat, Data* binary) const;
+
+    /** Hints the driver that getProgramBinary() will be called on this program. Call it before link().
+     * @js NA
+     * @lua NA
+     * @since v3.17
+     */
+    void setProgramBinaryRetrievable(bool retrievable) { _binaryRetrievable = retrievable; }
     /** it will call glUseProgram() */
     void use();
 /** It will create 4 uniforms:
@@ -569,6 +598,7 @@ protected:
     void clearShader();
 
     void clearHashUniforms();
+    bool isBuiltInUniformLocation(GLint location) const;
 
     /**OpenGL handle for program.*/
     GLuint            _program;
@@ -580,6 +610,8 @@ protected:
     GLint             _builtInUniforms[UNIFORM_MAX];
     /**Indicate whether it has a offline shader compiler or not.*/
     bool              _hasShaderCompiler;
+    /**Whether the driver is told that the binary of the program will be retrieved.*/
+    bool              _binaryRetrievable;
 
     /**User defined Uniforms.*/
     std::unordered_map<std::string, Uniform> _userUniforms;
@@ -592,6 +624,11 @@ protected:
 
     /*needed uniforms*/
     UniformFlags _flags;
+
+    /**Frame in which the time uniforms were last sent, they only change once per frame.*/
+    unsigned int _builtInTimeFrame;
+    /**The GLProgramState whose user uniform values are the ones in the program, compared only.*/
+    const void* _userUniformsOwner;
 };
 
 NS_CC_END
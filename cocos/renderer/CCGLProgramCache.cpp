@@ -34,6 +34,9 @@ THE SOFTWARE.
 #include "base/CCEventListenerCustom.h"
 #include "base/CCDirector.h"
 #include "base/CCEventDispatcher.h"
+#include "base/CCData.h"
+#include "platform/CCFileUtils.h"
+#include "xxhash.h"
 
 NS_CC_BEGIN
 
@@ -109,8 +112,23 @@ void GLProgramCache::purgeSharedShaderCache()
     GLProgramCache::destroyInstance();
 }
 
+// header of a program binary file, followed by the binary
+struct ProgramBinaryHeader
+{
+    char magic[4];
+    uint32_t version;
+    // second hash of the key, the first one is the file name
+    uint32_t keyCheck;
+    uint32_t binaryFormat;
+};
+
+static const char PROGRAM_BINARY_MAGIC[4] = { 'C', 'C', 'P', 'B' };
+static const uint32_t PROGRAM_BINARY_VERSION = 1;
+static const unsigned int PROGRAM_BINARY_KEY_CHECK_SEED = 0x9E3779B9;
+
 GLProgramCache::GLProgramCache()
 : _programs()
+, _binaryCacheEnabled(false)
 {
 
 }
@@ -126,6 +144,9 @@ GLProgramCache::~GLProgramCache()
 
 bool GLProgramCache::init()
 {
+    auto conf = Configuration::getInstance();
+    _binaryCacheEnabled = conf->supportsProgramBinary() && conf->getValue("cocos2d.x.gl.program_binary_cache", Value(false)).asBool();
+
     loadDefaultGLPrograms();
     
     auto listener = EventListenerCustom::create(Configuration::CONFIG_FILE_LOADED, [this](EventCustom* /*event*/){
@@ -503,141 +524,190 @@ void GLProgramCache::reloadDefaultGLProgramsRelativeToLights()
 
 void GLProgramCache::loadDefaultGLProgram(GLProgram *p, int type)
 {
+    std::string vert;
+    std::string frag;
+
     switch (type) {
         case kShaderType_PositionTextureColor:
-            p->initWithByteArrays(ccPositionTextureColor_vert, ccPositionTextureColor_frag);
+            vert = ccPositionTextureColor_vert;
+            frag = ccPositionTextureColor_frag;
             break;
         case kShaderType_PositionTextureColor_noMVP:
-            p->initWithByteArrays(ccPositionTextureColor_noMVP_vert, ccPositionTextureColor_noMVP_frag);
+            vert = ccPositionTextureColor_noMVP_vert;
+            frag = ccPositionTextureColor_noMVP_frag;
             break;
         case kShaderType_PositionTextureColorAlphaTest:
-            p->initWithByteArrays(ccPositionTextureColor_vert, ccPositionTextureColorAlphaTest_frag);
+            vert = ccPositionTextureColor_vert;
+            frag = ccPositionTextureColorAlphaTest_frag;
             break;
         case kShaderType_PositionTextureColorAlphaTestNoMV:
-            p->initWithByteArrays(ccPositionTextureColor_noMVP_vert, ccPositionTextureColorAlphaTest_frag);
+            vert = ccPositionTextureColor_noMVP_vert;
+            frag = ccPositionTextureColorAlphaTest_frag;
             break;
         case kShaderType_PositionColor:
-            p->initWithByteArrays(ccPositionColor_vert ,ccPositionColor_frag);
+            vert = ccPositionColor_vert;
+            frag = ccPositionColor_frag;
             break;
         case kShaderType_PositionColorTextureAsPointsize:
-            p->initWithByteArrays(ccPositionColorTextureAsPointsize_vert ,ccPositionColor_frag);
+            vert = ccPositionColorTextureAsPointsize_vert;
+            frag = ccPositionColor_frag;
             break;
         case kShaderType_PositionColor_noMVP:
-            p->initWithByteArrays(ccPositionTextureColor_noMVP_vert ,ccPositionColor_frag);
+            vert = ccPositionTextureColor_noMVP_vert;
+            frag = ccPositionColor_frag;
             break;
         case kShaderType_PositionTexture:
-            p->initWithByteArrays(ccPositionTexture_vert ,ccPositionTexture_frag);
+            vert = ccPositionTexture_vert;
+            frag = ccPositionTexture_frag;
             break;
         case kShaderType_PositionTexture_uColor:
-            p->initWithByteArrays(ccPositionTexture_uColor_vert, ccPositionTexture_uColor_frag);
+            vert = ccPositionTexture_uColor_vert;
+            frag = ccPositionTexture_uColor_frag;
             break;
         case kShaderType_PositionTextureA8Color:
-            p->initWithByteArrays(ccPositionTextureA8Color_vert, ccPositionTextureA8Color_frag);
+            vert = ccPositionTextureA8Color_vert;
+            frag = ccPositionTextureA8Color_frag;
             break;
         case kShaderType_Position_uColor:
-            p->initWithByteArrays(ccPosition_uColor_vert, ccPosition_uColor_frag);
-            p->bindAttribLocation("aVertex", GLProgram::VERTEX_ATTRIB_POSITION);
+            vert = ccPosition_uColor_vert;
+            frag = ccPosition_uColor_frag;
             break;
         case kShaderType_PositionLengthTextureColor:
-            p->initWithByteArrays(ccPositionColorLengthTexture_vert, ccPositionColorLengthTexture_frag);
+            vert = ccPositionColorLengthTexture_vert;
+            frag = ccPositionColorLengthTexture_frag;
             break;
         case kShaderType_LabelDistanceFieldNormal:
-            p->initWithByteArrays(ccLabel_vert, ccLabelDistanceFieldNormal_frag);
+            vert = ccLabel_vert;
+            frag = ccLabelDistanceFieldNormal_frag;
             break;
         case kShaderType_LabelDistanceFieldGlow:
-            p->initWithByteArrays(ccLabel_vert, ccLabelDistanceFieldGlow_frag);
+            vert = ccLabel_vert;
+            frag = ccLabelDistanceFieldGlow_frag;
             break;
         case kShaderType_UIGrayScale:
-            p->initWithByteArrays(ccPositionTextureColor_noMVP_vert,
-                                  ccPositionTexture_GrayScale_frag);
+            vert = ccPositionTextureColor_noMVP_vert;
+            frag = ccPositionTexture_GrayScale_frag;
             break;
         case kShaderType_LabelNormal:
-            p->initWithByteArrays(ccLabel_vert, ccLabelNormal_frag);
+            vert = ccLabel_vert;
+            frag = ccLabelNormal_frag;
             break;
         case kShaderType_LabelOutline:
-            p->initWithByteArrays(ccLabel_vert, ccLabelOutline_frag);
+            vert = ccLabel_vert;
+            frag = ccLabelOutline_frag;
             break;
         case kShaderType_3DPosition:
-            p->initWithByteArrays(cc3D_PositionTex_vert, cc3D_Color_frag);
+            vert = cc3D_PositionTex_vert;
+            frag = cc3D_Color_frag;
             break;
         case kShaderType_3DPositionTex:
-            p->initWithByteArrays(cc3D_PositionTex_vert, cc3D_ColorTex_frag);
+            vert = cc3D_PositionTex_vert;
+            frag = cc3D_ColorTex_frag;
             break;
         case kShaderType_3DSkinPositionTex:
-            p->initWithByteArrays(cc3D_SkinPositionTex_vert, cc3D_ColorTex_frag);
+            vert = cc3D_SkinPositionTex_vert;
+            frag = cc3D_ColorTex_frag;
             break;
         case kShaderType_3DPositionNormal:
             {
                 std::string def = getShaderMacrosForLight();
-                p->initWithByteArrays((def + std::string(cc3D_PositionNormalTex_vert)).c_str(), (def + std::string(cc3D_ColorNormal_frag)).c_str());
+                vert = def + cc3D_PositionNormalTex_vert;
+                frag = def + cc3D_ColorNormal_frag;
             }
             break;
         case kShaderType_3DPositionNormalTex:
             {
                 std::string def = getShaderMacrosForLight();
-                p->initWithByteArrays((def + std::string(cc3D_PositionNormalTex_vert)).c_str(), (def + std::string(cc3D_ColorNormalTex_frag)).c_str());
+                vert = def + cc3D_PositionNormalTex_vert;
+                frag = def + cc3D_ColorNormalTex_frag;
             }
             break;
         case kShaderType_3DSkinPositionNormalTex:
             {
                 std::string def = getShaderMacrosForLight();
-                p->initWithByteArrays((def + std::string(cc3D_SkinPositionNormalTex_vert)).c_str(), (def + std::string(cc3D_ColorNormalTex_frag)).c_str());
+                vert = def + cc3D_SkinPositionNormalTex_vert;
+                frag = def + cc3D_ColorNormalTex_frag;
             }
             break;
         case kShaderType_3DPositionBumpedNormalTex:
             {
                 std::string def = getShaderMacrosForLight();
                 std::string normalMapDef = "\n#define USE_NORMAL_MAPPING 1 \n";
-                p->initWithByteArrays((def + normalMapDef + std::string(cc3D_PositionNormalTex_vert)).c_str(), (def + normalMapDef + std::string(cc3D_ColorNormalTex_frag)).c_str());
+                vert = def + normalMapDef + cc3D_PositionNormalTex_vert;
+                frag = def + normalMapDef + cc3D_ColorNormalTex_frag;
             }
             break;
         case kShaderType_3DSkinPositionBumpedNormalTex:
             {
                 std::string def = getShaderMacrosForLight();
                 std::string normalMapDef = "\n#define USE_NORMAL_MAPPING 1 \n";
-                p->initWithByteArrays((def + normalMapDef + std::string(cc3D_SkinPositionNormalTex_vert)).c_str(), (def + normalMapDef + std::string(cc3D_ColorNormalTex_frag)).c_str());
+                vert = def + normalMapDef + cc3D_SkinPositionNormalTex_vert;
+                frag = def + normalMapDef + cc3D_ColorNormalTex_frag;
             }
             break;
         case kShaderType_3DParticleTex:
            {
-                p->initWithByteArrays(cc3D_Particle_vert, cc3D_Particle_tex_frag);
+                vert = cc3D_Particle_vert;
+                frag = cc3D_Particle_tex_frag;
            }
             break;
         case kShaderType_3DParticleColor:
-            p->initWithByteArrays(cc3D_Particle_vert, cc3D_Particle_color_frag);
+            vert = cc3D_Particle_vert;
+            frag = cc3D_Particle_color_frag;
             break;
         case kShaderType_3DSkyBox:
-            p->initWithByteArrays(cc3D_Skybox_vert, cc3D_Skybox_frag);
+            vert = cc3D_Skybox_vert;
+            frag = cc3D_Skybox_frag;
             break;
         case kShaderType_3DTerrain:
-            p->initWithByteArrays(cc3D_Terrain_vert, cc3D_Terrain_frag);
+            vert = cc3D_Terrain_vert;
+            frag = cc3D_Terrain_frag;
             break;
         case kShaderType_CameraClear:
-            p->initWithByteArrays(ccCameraClearVert, ccCameraClearFrag);
+            vert = ccCameraClearVert;
+            frag = ccCameraClearFrag;
             break;
             /// ETC1 ALPHA supports.
         case kShaderType_ETC1ASPositionTextureColor:
-            p->initWithByteArrays(ccPositionTextureColor_vert, ccETC1ASPositionTextureColor_frag);
+            vert = ccPositionTextureColor_vert;
+            frag = ccETC1ASPositionTextureColor_frag;
             break;
         case kShaderType_ETC1ASPositionTextureColor_noMVP:
-            p->initWithByteArrays(ccPositionTextureColor_noMVP_vert, ccETC1ASPositionTextureColor_frag);
+            vert = ccPositionTextureColor_noMVP_vert;
+            frag = ccETC1ASPositionTextureColor_frag;
             break;
             /// ETC1 GRAY supports.
         case kShaderType_ETC1ASPositionTextureGray:
-            p->initWithByteArrays(ccPositionTextureColor_vert, ccETC1ASPositionTextureGray_frag);
+            vert = ccPositionTextureColor_vert;
+            frag = ccETC1ASPositionTextureGray_frag;
             break;
         case kShaderType_ETC1ASPositionTextureGray_noMVP:
-            p->initWithByteArrays(ccPositionTextureColor_noMVP_vert, ccETC1ASPositionTextureGray_frag);
+            vert = ccPositionTextureColor_noMVP_vert;
+            frag = ccETC1ASPositionTextureGray_frag;
             break;
         case kShaderType_LayerRadialGradient:
-            p->initWithByteArrays(ccPosition_vert, ccShader_LayerRadialGradient_frag);
+            vert = ccPosition_vert;
+            frag = ccShader_LayerRadialGradient_frag;
             break;
         default:
             CCLOG("cocos2d: %s:%d, error shader type", __FUNCTION__, __LINE__);
             return;
     }
 
-    p->link();
+    // the binary only has to be rejected once, the new one replaces it
+    if (!_binaryCacheEnabled || !loadProgramBinary(p, vert, frag))
+    {
+        p->initWithByteArrays(vert.c_str(), frag.c_str());
+        if (type == kShaderType_Position_uColor)
+        {
+            p->bindAttribLocation("aVertex", GLProgram::VERTEX_ATTRIB_POSITION);
+        }
+        p->setProgramBinaryRetrievable(_binaryCacheEnabled);
+        if (p->link() && _binaryCacheEnabled)
+        {
+            saveProgramBinary(p, vert, frag);
+        }
+    }
     p->updateUniforms();
 
     CHECK_GL_ERROR_DEBUG();
@@ -666,6 +736,118 @@ void GLProgramCache::addGLProgram(GLProgram* program, const std::string &key)
     _programs[key] = program;
 }
 
+void GLProgramCache::setBinaryCacheEnabled(bool enabled)
+{
+    _binaryCacheEnabled = enabled && Configuration::getInstance()->supportsProgramBinary();
+}
+
+void GLProgramCache::removeBinaryCache()
+{
+    auto fileUtils = FileUtils::getInstance();
+    std::string dir = fileUtils->getWritablePath() + "glprogram_binaries/";
+    if (fileUtils->isDirectoryExist(dir))
+    {
+        fileUtils->removeDirectory(dir);
+    }
+}
+
+std::string GLProgramCache::getBinaryCachePath(const std::string& vert, const std::string& frag, unsigned int* keyCheck) const
+{
+    // a binary is only valid for the driver which created it
+    auto conf = Configuration::getInstance();
+    std::string key = vert;
+    key += '\0';
+    key += frag;
+    key += '\0';
+    key += conf->getValue("cocos2d.x.version").asString();
+    key += '\0';
+    key += conf->getValue("gl.vendor").asString();
+    key += '\0';
+    key += conf->getValue("gl.renderer").asString();
+    key += '\0';
+    key += conf->getValue("gl.version").asString();
+
+    *keyCheck = XXH32(key.data(), (int)key.size(), PROGRAM_BINARY_KEY_CHECK_SEED);
+
+    char name[16];
+    snprintf(name, sizeof(name), "%08x.bin", XXH32(key.data(), (int)key.size(), 0));
+    return FileUtils::getInstance()->getWritablePath() + "glprogram_binaries/" + name;
+}
+
+bool GLProgramCache::loadProgramBinary(GLProgram* program, const std::string& vert, const std::string& frag)
+{
+    unsigned int keyCheck = 0;
+    std::string path = getBinaryCachePath(vert, frag, &keyCheck);
+
+    auto fileUtils = FileUtils::getInstance();
+    if (!fileUtils->isFileExist(path))
+    {
+        return false;
+    }
+
+    Data data = fileUtils->getDataFromFile(path);
+    if (data.getSize() <= (ssize_t)sizeof(ProgramBinaryHeader))
+    {
+        return false;
+    }
+
+    ProgramBinaryHeader header;
+    memcpy(&header, data.getBytes(), sizeof(header));
+    if (memcmp(header.magic, PROGRAM_BINARY_MAGIC, sizeof(header.magic)) != 0
+        || header.version != PROGRAM_BINARY_VERSION
+        || header.keyCheck != keyCheck)
+    {
+        return false;
+    }
+
+    return program->initWithProgramBinary(header.binaryFormat,
+                                          data.getBytes() + sizeof(header),
+                                          (GLsizei)(data.getSize() - sizeof(header)));
+}
+
+void GLProgramCache::saveProgramBinary(GLProgram* program, const std::string& vert, const std::string& frag)
+{
+    GLenum binaryFormat = 0;
+    Data binary;
+    if (!program->getProgramBinary(&binaryFormat, &binary))
+    {
+        return;
+    }
+
+    unsigned int keyCheck = 0;
+    std::string path = getBinaryCachePath(vert, frag, &keyCheck);
+
+    auto fileUtils = FileUtils::getInstance();
+    std::string dir = fileUtils->getWritablePath() + "glprogram_binaries/";
+    if (!fileUtils->isDirectoryExist(dir) && !fileUtils->createDirectory(dir))
+    {
+        CCLOG("cocos2d: GLProgramCache: can't create %s", dir.c_str());
+        return;
+    }
+
+    ProgramBinaryHeader header;
+    memcpy(header.magic, PROGRAM_BINARY_MAGIC, sizeof(header.magic));
+    header.version = PROGRAM_BINARY_VERSION;
+    header.keyCheck = keyCheck;
+    header.binaryFormat = binaryFormat;
+
+    const ssize_t size = sizeof(header) + binary.getSize();
+    auto bytes = (unsigned char*)malloc(size);
+    if (bytes == nullptr)
+    {
+        return;
+    }
+    memcpy(bytes, &header, sizeof(header));
+    memcpy(bytes + sizeof(header), binary.getBytes(), binary.getSize());
+
+    Data file;
+    file.fastSet(bytes, size);
+    if (!fileUtils->writeDataToFile(file, path))
+    {
+        CCLOG("cocos2d: GLProgramCache: can't write %s", path.c_str());
+    }
+}
+
 std::string GLProgramCache::getShaderMacrosForLight() const
 {
     GLchar def[256];
@@ -94,6 +94,28 @@ public:
     /** reload default programs these are relative to light */
     void reloadDefaultGLProgramsRelativeToLights();
 
+    /**
+     Enables or disables the program binary cache.
+     When enabled, the default programs are saved (glGetProgramBinary) under the writable path once linked,
+     and loaded from there on the next launch or after a context loss instead of being compiled again.
+     A binary is keyed by the hash of its sources and of the GL vendor, renderer and version, and it is compiled again
+     from the sources when the driver rejects it.
+     The default value is the "cocos2d.x.gl.program_binary_cache" configuration value, false if it isn't set.
+     As the default programs are loaded with the cache, set this configuration value to cache them on the first launch.
+     It has no effect if Configuration::supportsProgramBinary() is false.
+     * @since v3.17
+     */
+    void setBinaryCacheEnabled(bool enabled);
+    /** Whether the program binary cache is enabled.
+     * @since v3.17
+     */
+    bool isBinaryCacheEnabled() const { return _binaryCacheEnabled; }
+
+    /** Removes all the program binaries saved under the writable path.
+     * @since v3.17
+     */
+    void removeBinaryCache();
+
 private:
     /**
     @{
@@ -108,8 +130,15 @@ private:
     /**Get macro define for lights in current openGL driver.*/
     std::string getShaderMacrosForLight() const;
 
+    /**Program binary cache.*/
+    std::string getBinaryCachePath(const std::string& vert, const std::string& frag, unsigned int* keyCheck) const;
+    bool loadProgramBinary(GLProgram* program, const std::string& vert, const std::string& frag);
+    void saveProgramBinary(GLProgram* program, const std::string& vert, const std::string& frag);
+
     /**Predefined shaders.*/
     std::unordered_map<std::string, GLProgram*> _programs;
+
+    bool _binaryCacheEnabled;
 };
 
 NS_CC_END
@@ -55,6 +55,7 @@ UniformValue::UniformValue()
 : _uniform(nullptr)
 , _glprogram(nullptr)
 , _type(Type::VALUE)
+, _dirty(true)
 {
 }
 
@@ -62,6 +63,7 @@ UniformValue::UniformValue(Uniform *uniform, GLProgram* glprogram)
 : _uniform(uniform)
 , _glprogram(glprogram)
 , _type(Type::VALUE)
+, _dirty(true)
 {
 }
 
@@ -81,8 +83,16 @@ UniformValue::~UniformValue()
     }
 }
 
+bool UniformValue::isAlwaysApplied() const
+{
+    // the pointed values may have changed, and the textures are bound to units shared by all the programs
+    return _type != Type::VALUE || _uniform->type == GL_SAMPLER_2D || _uniform->type == GL_SAMPLER_CUBE;
+}
+
 void UniformValue::apply()
 {
+    _dirty = false;
+
     if (_type == Type::CALLBACK_FN)
     {
         (*_value.callback)(_glprogram, _uniform);
@@ -198,6 +208,7 @@ void UniformValue::setTexture(Texture2D* texture, GLuint textureUnit)
 void UniformValue::setInt(int value)
 {
     CCASSERT(_uniform->type == GL_INT, "Wrong type: expecting GL_INT");
+    _dirty |= _type != Type::VALUE || _value.intValue != value;
     _value.intValue = value;
     _type = Type::VALUE;
 }
@@ -205,6 +216,7 @@ void UniformValue::setInt(int value)
 void UniformValue::setFloat(float value)
 {
     CCASSERT(_uniform->type == GL_FLOAT, "Wrong type: expecting GL_FLOAT");
+    _dirty |= _type != Type::VALUE || _value.floatValue != value;
     _value.floatValue = value;
     _type = Type::VALUE;
 }
@@ -220,6 +232,7 @@ void UniformValue::setFloatv(ssize_t size, const float* pointer)
 void UniformValue::setVec2(const Vec2& value)
 {
     CCASSERT(_uniform->type == GL_FLOAT_VEC2, "Wrong type: expecting GL_FLOAT_VEC2");
+    _dirty |= _type != Type::VALUE || memcmp(_value.v2Value, &value, sizeof(_value.v2Value)) != 0;
 	memcpy(_value.v2Value, &value, sizeof(_value.v2Value));
     _type = Type::VALUE;
 }
@@ -235,6 +248,7 @@ void UniformValue::setVec2v(ssize_t size, const Vec2* pointer)
 void UniformValue::setVec3(const Vec3& value)
 {
     CCASSERT(_uniform->type == GL_FLOAT_VEC3, "Wrong type: expecting GL_FLOAT_VEC3");
+    _dirty |= _type != Type::VALUE || memcmp(_value.v3Value, &value, sizeof(_value.v3Value)) != 0;
 	memcpy(_value.v3Value, &value, sizeof(_value.v3Value));
     _type = Type::VALUE;
 
@@ -251,6 +265,7 @@ void UniformValue::setVec3v(ssize_t size, const Vec3* pointer)
 void UniformValue::setVec4(const Vec4& value)
 {
     CCASSERT (_uniform->type == GL_FLOAT_VEC4, "Wrong type: expecting GL_FLOAT_VEC4");
+    _dirty |= _type != Type::VALUE || memcmp(_value.v4Value, &value, sizeof(_value.v4Value)) != 0;
 	memcpy(_value.v4Value, &value, sizeof(_value.v4Value));
     _type = Type::VALUE;
 }
@@ -266,6 +281,7 @@ void UniformValue::setVec4v(ssize_t size, const Vec4* pointer)
 void UniformValue::setMat4(const Mat4& value)
 {
     CCASSERT(_uniform->type == GL_FLOAT_MAT4, "_uniform's type should be equal GL_FLOAT_MAT4.");
+    _dirty |= _type != Type::VALUE || memcmp(_value.matrixValue, &value, sizeof(_value.matrixValue)) != 0;
 	memcpy(_value.matrixValue, &value, sizeof(_value.matrixValue));
     _type = Type::VALUE;
 }
@@ -275,6 +291,7 @@ UniformValue& UniformValue::operator=(const UniformValue& o)
     _uniform = o._uniform;
     _glprogram = o._glprogram;
     _type = o._type;
+    _dirty = o._dirty;
     _value = o._value;
     
     if (_uniform->type == GL_SAMPLER_2D)
@@ -461,6 +478,7 @@ GLProgramState* GLProgramState::clone() const
 
     // copy uniforms
     glprogramstate->_uniformsByName = this->_uniformsByName;
+    glprogramstate->_uniformsByLocation = this->_uniformsByLocation;
     glprogramstate->_uniforms = this->_uniforms;
     glprogramstate->_uniformAttributeValueDirty = this->_uniformAttributeValueDirty;
 
@@ -500,10 +518,13 @@ bool GLProgramState::init(GLProgram* glprogram)
         _attributes[attrib.first] = value;
     }
 
+    // the values are copied when the vector grows
+    _uniforms.reserve(_glprogram->_userUniforms.size());
     for(auto &uniform : _glprogram->_userUniforms) {
-        UniformValue value(&uniform.second, _glprogram);
-        _uniforms[uniform.second.location] = std::move(value);
-        _uniformsByName[uniform.first] = uniform.second.location;
+        const int index = (int)_uniforms.size();
+        _uniforms.push_back(UniformValue(&uniform.second, _glprogram));
+        _uniformsByName[uniform.first] = index;
+        _uniformsByLocation[uniform.second.location] = index;
     }
 
     return true;
@@ -515,6 +536,8 @@ void GLProgramState::resetGLProgram()
     // the destructor of UniformValue will call a weak pointer
     // which points to the member variable in GLProgram.
     _uniforms.clear();
+    _uniformsByName.clear();
+    _uniformsByLocation.clear();
     _attributes.clear();
 
     CC_SAFE_RELEASE(_glprogram);
@@ -538,9 +561,12 @@ void GLProgramState::updateUniformsAndAttributes()
     CCASSERT(_glprogram, "invalid glprogram");
     if(_uniformAttributeValueDirty)
     {
-        for(auto& uniformLocation : _uniformsByName)
+        // the values were lost with the context, send them all again
+        for(auto& uniformIndex : _uniformsByName)
         {
-            _uniforms[uniformLocation.second]._uniform = _glprogram->getUniform(uniformLocation.first);
+            auto& uniformValue = _uniforms[uniformIndex.second];
+            uniformValue._uniform = _glprogram->getUniform(uniformIndex.first);
+            uniformValue._dirty = true;
         }
         
         _vertexAttribsFlags = 0;
@@ -585,9 +611,13 @@ void GLProgramState::applyUniforms()
 {
     // set uniforms
     updateUniformsAndAttributes();
+    // if the program still holds the values sent by this state, only send the ones which changed since then
+    const bool programUpToDate = _glprogram->_userUniformsOwner == this;
     for(auto& uniform : _uniforms) {
-        uniform.second.apply();
+        if (!programUpToDate || uniform._dirty || uniform.isAlwaysApplied())
+            uniform.apply();
     }
+    _glprogram->_userUniformsOwner = this;
 }
 
 void GLProgramState::setGLProgram(GLProgram *glprogram)
@@ -613,9 +643,9 @@ ssize_t GLProgramState::getVertexAttribCount() const
 UniformValue* GLProgramState::getUniformValue(GLint uniformLocation)
 {
     updateUniformsAndAttributes();
-    const auto itr = _uniforms.find(uniformLocation);
-    if (itr != _uniforms.end())
-        return &itr->second;
+    const auto itr = _uniformsByLocation.find(uniformLocation);
+    if (itr != _uniformsByLocation.end())
+        return &_uniforms[itr->second];
     return nullptr;
 }
 
@@ -628,6 +658,22 @@ UniformValue* GLProgramState::getUniformValue(const std::string& name)
     return nullptr;
 }
 
+UniformValue* GLProgramState::getUniformValue(const UniformHandle& handle)
+{
+    updateUniformsAndAttributes();
+    if (handle.index >= 0 && handle.index < (int)_uniforms.size())
+        return &_uniforms[handle.index];
+    return nullptr;
+}
+
+GLProgramState::UniformHandle GLProgramState::getUniformHandle(const std::string& uniformName) const
+{
+    const auto itr = _uniformsByName.find(uniformName);
+    if (itr != _uniformsByName.end())
+        return UniformHandle(itr->second);
+    return UniformHandle();
+}
+
 VertexAttribValue* GLProgramState::getVertexAttribValue(const std::string& name)
 {
     updateUniformsAndAttributes();
@@ -954,6 +1000,120 @@ void GLProgramState::setUniformTexture(GLint uniformLocation, GLuint textureId)
     }
 }
 
+// Uniform setters by handle
+
+void GLProgramState::setUniformInt(const UniformHandle& handle, int value)
+{
+    auto v = getUniformValue(handle);
+    if (v)
+        v->setInt(value);
+    else
+        CCLOG("cocos2d: warning: Uniform handle not found: %i", handle.index);
+}
+
+void GLProgramState::setUniformFloat(const UniformHandle& handle, float value)
+{
+    auto v = getUniformValue(handle);
+    if (v)
+        v->setFloat(value);
+    else
+        CCLOG("cocos2d: warning: Uniform handle not found: %i", handle.index);
+}
+
+void GLProgramState::setUniformFloatv(const UniformHandle& handle, ssize_t size, const float* pointer)
+{
+    auto v = getUniformValue(handle);
+    if (v)
+        v->setFloatv(size, pointer);
+    else
+        CCLOG("cocos2d: warning: Uniform handle not found: %i", handle.index);
+}
+
+void GLProgramState::setUniformVec2(const UniformHandle& handle, const Vec2& value)
+{
+    auto v = getUniformValue(handle);
+    if (v)
+        v->setVec2(value);
+    else
+        CCLOG("cocos2d: warning: Uniform handle not found: %i", handle.index);
+}
+
+void GLProgramState::setUniformVec2v(const UniformHandle& handle, ssize_t size, const Vec2* pointer)
+{
+    auto v = getUniformValue(handle);
+    if (v)
+        v->setVec2v(size, pointer);
+    else
+        CCLOG("cocos2d: warning: Uniform handle not found: %i", handle.index);
+}
+
+void GLProgramState::setUniformVec3(const UniformHandle& handle, const Vec3& value)
+{
+    auto v = getUniformValue(handle);
+    if (v)
+        v->setVec3(value);
+    else
+        CCLOG("cocos2d: warning: Uniform handle not found: %i", handle.index);
+}
+
+void GLProgramState::setUniformVec3v(const UniformHandle& handle, ssize_t size, const Vec3* pointer)
+{
+    auto v = getUniformValue(handle);
+    if (v)
+        v->setVec3v(size, pointer);
+    else
+        CCLOG("cocos2d: warning: Uniform handle not found: %i", handle.index);
+}
+
+void GLProgramState::setUniformVec4(const UniformHandle& handle, const Vec4& value)
+{
+    auto v = getUniformValue(handle);
+    if (v)
+        v->setVec4(value);
+    else
+        CCLOG("cocos2d: warning: Uniform handle not found: %i", handle.index);
+}
+
+void GLProgramState::setUniformVec4v(const UniformHandle& handle, ssize_t size, const Vec4* pointer)
+{
+    auto v = getUniformValue(handle);
+    if (v)
+        v->setVec4v(size, pointer);
+    else
+        CCLOG("cocos2d: warning: Uniform handle not found: %i", handle.index);
+}
+
+void GLProgramState::setUniformMat4(const UniformHandle& handle, const Mat4& value)
+{
+    auto v = getUniformValue(handle);
+    if (v)
+        v->setMat4(value);
+    else
+        CCLOG("cocos2d: warning: Uniform handle not found: %i", handle.index);
+}
+
+void GLProgramState::setUniformTexture(const UniformHandle& handle, Texture2D *texture)
+{
+    CCASSERT(texture, "Invalid texture");
+    auto v = getUniformValue(handle);
+    if (v)
+    {
+        if (_boundTextureUnits.find(v->_uniform->name) != _boundTextureUnits.end())
+        {
+            v->setTexture(texture, _boundTextureUnits[v->_uniform->name]);
+        }
+        else
+        {
+            v->setTexture(texture, _textureUnitIndex);
+            _boundTextureUnits[v->_uniform->name] = _textureUnitIndex++;
+        }
+    }
+    else
+    {
+        CCLOG("cocos2d: warning: Uniform handle not found: %i", handle.index);
+    }
+}
+
 // Auto bindings
 void GLProgramState::setParameterAutoBinding(const std::string& uniformName, const std::string& autoBinding)
 {
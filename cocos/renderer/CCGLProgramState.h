@@ -134,6 +134,11 @@ protected:
     GLProgram* _glprogram;
     /** What kind of type is the Uniform */
     Type _type;
+    /** Whether the value changed since it was last applied */
+    bool _dirty;
+
+    /** Whether apply() has to be called even if the value didn't change, for pointers, callbacks and textures */
+    bool isAlwaysApplied() const;
 
     /**
      @name Uniform Value Uniform
@@ -255,6 +260,24 @@ class CC_DLL GLProgramState : public Ref
 {
     friend class GLProgramStateCache;
 public:
+    /**
+     A user defined uniform, resolved once by getUniformHandle().
+     Setting a uniform with its handle avoids looking its name or its location up on each call.
+     A handle is valid until setGLProgram() is called with another program, and it is still valid in a clone().
+     * @js NA
+     * @lua NA
+     * @since v3.17
+     */
+    struct UniformHandle
+    {
+        UniformHandle() : index(-1) {}
+        explicit UniformHandle(int uniformIndex) : index(uniformIndex) {}
+        /** Whether the uniform was found in the program. */
+        bool isValid() const { return index >= 0; }
+
+        int index;
+    };
+
     /** returns a new instance of GLProgramState for a given GLProgram */
     static GLProgramState* create(GLProgram* glprogram);
 
@@ -361,6 +384,34 @@ public:
     CC_DEPRECATED_ATTRIBUTE void setUniformTexture(GLint uniformLocation, GLuint textureId);
     /**@}*/
 
+    /**
+     Returns the handle of a user defined uniform, invalid if the program has no such uniform.
+     * @js NA
+     * @lua NA
+     * @since v3.17
+     */
+    UniformHandle getUniformHandle(const std::string& uniformName) const;
+
+    /** @{
+     Setting user defined uniforms by handle, see getUniformHandle().
+     Only the values which changed are sent by applyUniforms(), unless the uniforms of the program were set by someone else in the meantime.
+     * @js NA
+     * @lua NA
+     * @since v3.17
+     */
+    void setUniformInt(const UniformHandle& handle, int value);
+    void setUniformFloat(const UniformHandle& handle, float value);
+    void setUniformFloatv(const UniformHandle& handle, ssize_t size, const float* pointer);
+    void setUniformVec2(const UniformHandle& handle, const Vec2& value);
+    void setUniformVec2v(const UniformHandle& handle, ssize_t size, const Vec2* pointer);
+    void setUniformVec3(const UniformHandle& handle, const Vec3& value);
+    void setUniformVec3v(const UniformHandle& handle, ssize_t size, const Vec3* pointer);
+    void setUniformVec4(const UniformHandle& handle, const Vec4& value);
+    void setUniformVec4v(const UniformHandle& handle, ssize_t size, const Vec4* pointer);
+    void setUniformMat4(const UniformHandle& handle, const Mat4& value);
+    void setUniformTexture(const UniformHandle& handle, Texture2D *texture);
+    /**@}*/
+
     /** 
      * Returns the Node bound to the GLProgramState
      */
@@ -470,11 +521,14 @@ protected:
     VertexAttribValue* getVertexAttribValue(const std::string& attributeName);
     UniformValue* getUniformValue(const std::string& uniformName);
     UniformValue* getUniformValue(GLint uniformLocation);
+    UniformValue* getUniformValue(const UniformHandle& handle);
 
 
     bool _uniformAttributeValueDirty;
-    std::unordered_map<std::string, GLint> _uniformsByName;
-    std::unordered_map<GLint, UniformValue> _uniforms;
+    // indices in _uniforms, which are the uniform handles
+    std::unordered_map<std::string, int> _uniformsByName;
+    std::unordered_map<GLint, int> _uniformsByLocation;
+    std::vector<UniformValue> _uniforms;
     std::unordered_map<std::string, VertexAttribValue> _attributes;
     std::unordered_map<std::string, int> _boundTextureUnits;
 
@@ -40,12 +40,14 @@
 #include "renderer/ccGLStateCache.h"
 
 #include "base/CCConfiguration.h"
+#include "base/CCJobSystem.h"
 #include "base/CCDirector.h"
 #include "base/CCEventDispatcher.h"
 #include "base/CCEventListenerCustom.h"
 #include "base/CCEventType.h"
 #include "2d/CCCamera.h"
 #include "2d/CCScene.h"
+#include "math/MathUtil.h"
 
 NS_CC_BEGIN
 
@@ -60,6 +62,22 @@ static bool compare3DCommand(RenderCommand* a, RenderCommand* b)
     return  a->getDepth() > b->getDepth();
 }
 
+// Maps a float to an unsigned integer with the same ordering
+static uint32_t floatToSortKey(float value)
+{
+    // -0 and +0 must compare equal, as they do for floats
+    if (value == 0)
+        value = 0;
+
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    // negative: reverse all the bits. positive: set the sign bit so they come after negatives
+    return (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
+}
+
+// Below this size, std::stable_sort is faster than the radix sort
+static const size_t RADIX_SORT_MIN_SIZE = 64;
+
 // queue
 RenderQueue::RenderQueue()
 {
@@ -111,9 +129,78 @@ ssize_t RenderQueue::size() const
 void RenderQueue::sort()
 {
     // Don't sort _queue0, it already comes sorted
-    std::stable_sort(std::begin(_commands[QUEUE_GROUP::TRANSPARENT_3D]), std::end(_commands[QUEUE_GROUP::TRANSPARENT_3D]), compare3DCommand);
-    std::stable_sort(std::begin(_commands[QUEUE_GROUP::GLOBALZ_NEG]), std::end(_commands[QUEUE_GROUP::GLOBALZ_NEG]), compareRenderCommand);
-    std::stable_sort(std::begin(_commands[QUEUE_GROUP::GLOBALZ_POS]), std::end(_commands[QUEUE_GROUP::GLOBALZ_POS]), compareRenderCommand);
+    radixSort(_commands[QUEUE_GROUP::TRANSPARENT_3D], true);
+    radixSort(_commands[QUEUE_GROUP::GLOBALZ_NEG], false);
+    radixSort(_commands[QUEUE_GROUP::GLOBALZ_POS], false);
+}
+
+void RenderQueue::radixSort(std::vector<RenderCommand*>& commands, bool byDepth)
+{
+    const size_t count = commands.size();
+    if (count < 2)
+        return;
+
+    if (count < RADIX_SORT_MIN_SIZE)
+    {
+        if (byDepth)
+            std::stable_sort(std::begin(commands), std::end(commands), compare3DCommand);
+        else
+            std::stable_sort(std::begin(commands), std::end(commands), compareRenderCommand);
+        return;
+    }
+
+    _sortItems.resize(count);
+    _sortScratch.resize(count);
+
+    // histograms of the 4 key bytes, computed in a single pass
+    size_t histograms[4][256];
+    memset(histograms, 0, sizeof(histograms));
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto command = commands[i];
+        // the depth is sorted back to front, so its key is reversed
+        uint32_t key = byDepth ? ~floatToSortKey(command->getDepth()) : floatToSortKey(command->getGlobalOrder());
+        _sortItems[i].key = key;
+        _sortItems[i].command = command;
+
+        ++histograms[0][key & 0xff];
+        ++histograms[1][(key >> 8) & 0xff];
+        ++histograms[2][(key >> 16) & 0xff];
+        ++histograms[3][key >> 24];
+    }
+
+    // LSD radix sort: each pass is a stable counting sort on one byte
+    SortItem* src = _sortItems.data();
+    SortItem* dst = _sortScratch.data();
+    for (int pass = 0; pass < 4; ++pass)
+    {
+        size_t* histogram = histograms[pass];
+        const int shift = pass * 8;
+
+        // all the keys share this byte (common with few distinct global orders): nothing to do
+        if (histogram[(src[0].key >> shift) & 0xff] == count)
+            continue;
+
+        size_t offset = 0;
+        for (int bucket = 0; bucket < 256; ++bucket)
+        {
+            size_t bucketSize = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketSize;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            dst[histogram[(src[i].key >> shift) & 0xff]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        commands[i] = src[i].command;
+    }
 }
 
 RenderCommand* RenderQueue::operator[](ssize_t index) const
@@ -193,18 +280,48 @@ void RenderQueue::restoreRenderState()
 //
 static const int DEFAULT_RENDER_QUEUE = 0;
 
+static void setupVertexAttribPointers()
+{
+    // vertices
+    glEnableVertexAttribArray(GLProgram::VERTEX_ATTRIB_POSITION);
+    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(V3F_C4B_T2F), (GLvoid*) offsetof( V3F_C4B_T2F, vertices));
+
+    // colors
+    glEnableVertexAttribArray(GLProgram::VERTEX_ATTRIB_COLOR);
+    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(V3F_C4B_T2F), (GLvoid*) offsetof( V3F_C4B_T2F, colors));
+
+    // tex coords
+    glEnableVertexAttribArray(GLProgram::VERTEX_ATTRIB_TEX_COORD);
+    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORD, 2, GL_FLOAT, GL_FALSE, sizeof(V3F_C4B_T2F), (GLvoid*) offsetof( V3F_C4B_T2F, texCoords));
+}
+
 //
 // constructors, destructor, init
 //
 Renderer::Renderer()
 :_lastBatchedMeshCommand(nullptr)
+,_verts(nullptr)
+,_indices(nullptr)
+,_vboSize(0)
+,_indexVBOSize(0)
+,_indexType(GL_UNSIGNED_SHORT)
+,_indexSize(sizeof(GLushort))
+#if CC_RENDERER_USE_STREAMING_VBO
+,_streamingBufferIndex(0)
+,_isStreamingPersistent(false)
+#endif
+,_isStreaming(false)
+,_triBatchesToDrawCapacity(-1)
+,_triBatchesToDraw(nullptr)
 ,_filledVertex(0)
 ,_filledIndex(0)
 ,_glViewAssigned(false)
+,_streamingBufferStalls(0)
+,_reorderSavedBatches(0)
 ,_isRendering(false)
 ,_isDepthTestFor2D(false)
-,_triBatchesToDraw(nullptr)
-,_triBatchesToDrawCapacity(-1)
+,_isParallelFill(true)
+,_isReorderForBatching(false)
 #if CC_ENABLE_CACHE_TEXTURE_DATA
 ,_cacheTextureListener(nullptr)
 #endif
@@ -216,6 +333,7 @@ Renderer::Renderer()
     RenderQueue defaultRenderQueue;
     _renderGroups.push_back(defaultRenderQueue);
     _queuedTriangleCommands.reserve(BATCH_TRIAGCOMMAND_RESERVED_SIZE);
+    _queuedTriangleOffsets.reserve(BATCH_TRIAGCOMMAND_RESERVED_SIZE);
 
     // default clear color
     _clearColor = Color4F::BLACK;
@@ -223,6 +341,10 @@ Renderer::Renderer()
     // for the batched TriangleCommand
     _triBatchesToDrawCapacity = 500;
     _triBatchesToDraw = (TriBatchToDraw*) malloc(sizeof(_triBatchesToDraw[0]) * _triBatchesToDrawCapacity);
+
+#if CC_RENDERER_USE_STREAMING_VBO
+    memset(_streamingBuffers, 0, sizeof(_streamingBuffers));
+#endif
 }
 
 Renderer::~Renderer()
@@ -231,8 +353,11 @@ Renderer::~Renderer()
     _groupCommandManager->release();
     
     glDeleteBuffers(2, _buffersVBO);
+    deleteStreamingBuffers();
 
     free(_triBatchesToDraw);
+    free(_verts);
+    free(_indices);
 
     if (Configuration::getInstance()->supportsShareableVAO())
     {
@@ -255,6 +380,7 @@ void Renderer::initGLView()
     Director::getInstance()->getEventDispatcher()->addEventListenerWithFixedPriority(_cacheTextureListener, -1);
 #endif
 
+    setupBatchBuffers();
     setupBuffer();
     
     _glViewAssigned = true;
@@ -270,6 +396,81 @@ void Renderer::setupBuffer()
     {
         setupVBO();
     }
+
+    setupStreamingBuffers();
+}
+
+void Renderer::setupBatchBuffers()
+{
+    auto conf = Configuration::getInstance();
+    int vboSize = std::max(conf->getValue("cocos2d.x.renderer.vbo_size", Value(VBO_SIZE)).asInt(), 4);
+    GLenum indexType = GL_UNSIGNED_SHORT;
+    if (vboSize > MAX_VBO_SIZE_16BIT_INDICES)
+    {
+        if (conf->supportsElementIndexUint())
+        {
+            indexType = GL_UNSIGNED_INT;
+        }
+        else
+        {
+            CCLOG("cocos2d: Renderer: 32 bits indices are not supported, VBO size clamped to %d", MAX_VBO_SIZE_16BIT_INDICES);
+            vboSize = MAX_VBO_SIZE_16BIT_INDICES;
+        }
+    }
+
+    allocateBatchBuffers(vboSize, vboSize * 6 / 4, indexType);
+}
+
+void Renderer::allocateBatchBuffers(int vboSize, int indexVBOSize, GLenum indexType)
+{
+    // The content doesn't need to be preserved: the buffers are only (re)allocated when they are empty
+    free(_verts);
+    free(_indices);
+
+    _vboSize = vboSize;
+    _indexVBOSize = indexVBOSize;
+    _indexType = indexType;
+    _indexSize = (indexType == GL_UNSIGNED_INT) ? sizeof(GLuint) : sizeof(GLushort);
+    _verts = (V3F_C4B_T2F*) malloc(sizeof(_verts[0]) * _vboSize);
+    _indices = malloc(_indexSize * _indexVBOSize);
+}
+
+bool Renderer::growBatchBuffers(int vertexCount, int indexCount)
+{
+    CCASSERT(_filledVertex == 0 && _filledIndex == 0, "The queued triangles must be drawn before growing the buffers");
+
+    int vboSize = _vboSize;
+    while (vboSize < vertexCount)
+        vboSize *= 2;
+    int indexVBOSize = _indexVBOSize;
+    while (indexVBOSize < indexCount)
+        indexVBOSize *= 2;
+
+    GLenum indexType = _indexType;
+    if (vboSize > MAX_VBO_SIZE_16BIT_INDICES)
+    {
+        if (!Configuration::getInstance()->supportsElementIndexUint())
+        {
+            if (vertexCount > MAX_VBO_SIZE_16BIT_INDICES)
+                return false;
+            vboSize = MAX_VBO_SIZE_16BIT_INDICES;
+        }
+        else
+        {
+            indexType = GL_UNSIGNED_INT;
+        }
+    }
+
+    CCLOG("cocos2d: Renderer: batch buffers grown to %d vertices and %d indices", vboSize, indexVBOSize);
+    allocateBatchBuffers(vboSize, indexVBOSize, indexType);
+
+    // the streaming buffers have a fixed size
+    if (_isStreaming)
+    {
+        deleteStreamingBuffers();
+        setupStreamingBuffers();
+    }
+    return true;
 }
 
 void Renderer::setupVBOAndVAO()
@@ -290,20 +491,10 @@ void Renderer::setupVBOAndVAO()
     // For more discussion, please refer to https://github.com/cocos2d/cocos2d-x/issues/15652
     //glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * VBO_SIZE, _verts, GL_DYNAMIC_DRAW);
 
-    // vertices
-    glEnableVertexAttribArray(GLProgram::VERTEX_ATTRIB_POSITION);
-    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(V3F_C4B_T2F), (GLvoid*) offsetof( V3F_C4B_T2F, vertices));
-
-    // colors
-    glEnableVertexAttribArray(GLProgram::VERTEX_ATTRIB_COLOR);
-    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(V3F_C4B_T2F), (GLvoid*) offsetof( V3F_C4B_T2F, colors));
-
-    // tex coords
-    glEnableVertexAttribArray(GLProgram::VERTEX_ATTRIB_TEX_COORD);
-    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORD, 2, GL_FLOAT, GL_FALSE, sizeof(V3F_C4B_T2F), (GLvoid*) offsetof( V3F_C4B_T2F, texCoords));
+    setupVertexAttribPointers();
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * INDEX_VBO_SIZE, _indices, GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, _indexSize * _indexVBOSize, _indices, GL_STATIC_DRAW);
 
     // Must unbind the VAO before changing the element buffer.
     GL::bindVAO(0);
@@ -332,17 +523,182 @@ void Renderer::mapBuffers()
     GL::bindVAO(0);
 
     glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * VBO_SIZE, _verts, GL_DYNAMIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * _vboSize, _verts, GL_DYNAMIC_DRAW);
     
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * INDEX_VBO_SIZE, _indices, GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, _indexSize * _indexVBOSize, _indices, GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    CHECK_GL_ERROR_DEBUG();
+}
+
+void Renderer::setupStreamingBuffers()
+{
+#if CC_RENDERER_USE_STREAMING_VBO
+    // The buffers might belong to a lost context, so don't delete them here.
+    memset(_streamingBuffers, 0, sizeof(_streamingBuffers));
+    _streamingBufferIndex = 0;
 
+    auto conf = Configuration::getInstance();
+    _isStreaming = conf->supportsShareableVAO() && conf->supportsMapBufferRange() && conf->supportsFenceSync()
+        && conf->getValue("cocos2d.x.renderer.streaming_vbo", Value(true)).asBool();
+    if (!_isStreaming)
+        return;
+
+    _isStreamingPersistent = conf->supportsBufferStorage();
+
+    // Unlike the regular VBO (see Issue #15652), streaming buffers must have a fixed size:
+    // they are only mapped and written, never re-specified.
+    const GLsizeiptr vertexBytes = sizeof(_verts[0]) * _vboSize;
+    const GLsizeiptr indexBytes = _indexSize * _indexVBOSize;
+    const GLbitfield persistentFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    for (auto& slot : _streamingBuffers)
+    {
+        glGenVertexArrays(1, &slot.vao);
+        GL::bindVAO(slot.vao);
+
+        glGenBuffers(2, &slot.vbo[0]);
+        glBindBuffer(GL_ARRAY_BUFFER, slot.vbo[0]);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, slot.vbo[1]);
+
+        if (_isStreamingPersistent)
+        {
+            glBufferStorage(GL_ARRAY_BUFFER, vertexBytes, nullptr, persistentFlags);
+            glBufferStorage(GL_ELEMENT_ARRAY_BUFFER, indexBytes, nullptr, persistentFlags);
+            slot.mappedVerts = (V3F_C4B_T2F*) glMapBufferRange(GL_ARRAY_BUFFER, 0, vertexBytes, persistentFlags);
+            slot.mappedIndices = glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, indexBytes, persistentFlags);
+            if (!slot.mappedVerts || !slot.mappedIndices)
+            {
+                CCLOG("cocos2d: Renderer: persistent mapping failed, streaming buffers disabled");
+                _isStreaming = false;
+            }
+        }
+        else
+        {
+            glBufferData(GL_ARRAY_BUFFER, vertexBytes, nullptr, GL_STREAM_DRAW);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexBytes, nullptr, GL_STREAM_DRAW);
+        }
+
+        setupVertexAttribPointers();
+    }
+
+    GL::bindVAO(0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    if (!_isStreaming)
+        deleteStreamingBuffers();
 
     CHECK_GL_ERROR_DEBUG();
+#endif
+}
+
+void Renderer::deleteStreamingBuffers()
+{
+#if CC_RENDERER_USE_STREAMING_VBO
+    for (auto& slot : _streamingBuffers)
+    {
+        if (slot.fence)
+            glDeleteSync(slot.fence);
+        if (slot.vao)
+            glDeleteVertexArrays(1, &slot.vao);
+        // deleting a buffer also unmaps it
+        if (slot.vbo[0])
+            glDeleteBuffers(2, slot.vbo);
+    }
+    memset(_streamingBuffers, 0, sizeof(_streamingBuffers));
+    GL::bindVAO(0);
+#endif
+    _isStreaming = false;
+}
+
+bool Renderer::mapStreamingBuffer(int vertexCount, int indexCount, V3F_C4B_T2F** verts, void** indices)
+{
+#if CC_RENDERER_USE_STREAMING_VBO
+    // Batches are appended to the current slot. Once it is full, fence it and move to the next one:
+    // a single fence per slot covers all the draws that read from it.
+    auto* slot = &_streamingBuffers[_streamingBufferIndex];
+    if (slot->vertexOffset + vertexCount > _vboSize || slot->indexOffset + indexCount > _indexVBOSize)
+    {
+        slot->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        _streamingBufferIndex = (_streamingBufferIndex + 1) % VBO_STREAM_RING_SIZE;
+        slot = &_streamingBuffers[_streamingBufferIndex];
+
+        // Make sure the GPU is no longer reading the slot before writing into it
+        if (slot->fence)
+        {
+            GLenum result = glClientWaitSync(slot->fence, 0, 0);
+            if (result == GL_TIMEOUT_EXPIRED)
+            {
+                ++_streamingBufferStalls;
+                do {
+                    result = glClientWaitSync(slot->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+                } while (result == GL_TIMEOUT_EXPIRED);
+            }
+            glDeleteSync(slot->fence);
+            slot->fence = nullptr;
+        }
+        slot->vertexOffset = 0;
+        slot->indexOffset = 0;
+    }
+
+    GL::bindVAO(slot->vao);
+
+    if (_isStreamingPersistent)
+    {
+        *verts = slot->mappedVerts;
+        *indices = slot->mappedIndices;
+    }
+    else
+    {
+        // Only the free tail of the buffer is written, and the pending draws never read it:
+        // no need for the driver to synchronize.
+        const GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_FLUSH_EXPLICIT_BIT;
+        glBindBuffer(GL_ARRAY_BUFFER, slot->vbo[0]);
+        *verts = (V3F_C4B_T2F*) glMapBufferRange(GL_ARRAY_BUFFER, 0, sizeof(V3F_C4B_T2F) * _vboSize, access);
+        // the element array buffer is part of the VAO state
+        *indices = glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, _indexSize * _indexVBOSize, access);
+
+        if (!*verts || !*indices)
+        {
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            GL::bindVAO(0);
+            return false;
+        }
+    }
+
+    _filledVertex = slot->vertexOffset;
+    _filledIndex = slot->indexOffset;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Renderer::unmapStreamingBuffer()
+{
+#if CC_RENDERER_USE_STREAMING_VBO
+    auto& slot = _streamingBuffers[_streamingBufferIndex];
+
+    if (!_isStreamingPersistent)
+    {
+        glFlushMappedBufferRange(GL_ARRAY_BUFFER, sizeof(V3F_C4B_T2F) * slot.vertexOffset, sizeof(V3F_C4B_T2F) * (_filledVertex - slot.vertexOffset));
+        glFlushMappedBufferRange(GL_ELEMENT_ARRAY_BUFFER, _indexSize * slot.indexOffset, _indexSize * (_filledIndex - slot.indexOffset));
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    slot.vertexOffset = _filledVertex;
+    slot.indexOffset = _filledIndex;
+#endif
 }
 
 void Renderer::addCommand(RenderCommand* command)
@@ -358,6 +714,38 @@ void Renderer::addCommand(RenderCommand* command, int renderQueue)
     CCASSERT(command->getType() != RenderCommand::Type::UNKNOWN_COMMAND, "Invalid Command Type");
 
     _renderGroups[renderQueue].push_back(command);
+
+    for (const auto& recorder : _commandRecorders)
+    {
+        RecordedCommand recorded;
+        recorded.command = command;
+        recorded.renderQueue = (renderQueue == recorder.renderQueue) ? -1 : renderQueue;
+        recorder.commands->push_back(recorded);
+    }
+}
+
+void Renderer::pushCommandRecorder(std::vector<RecordedCommand>* commands)
+{
+    CommandRecorder recorder;
+    recorder.commands = commands;
+    recorder.renderQueue = _commandGroupStack.top();
+    _commandRecorders.push_back(recorder);
+}
+
+void Renderer::popCommandRecorder()
+{
+    CCASSERT(!_commandRecorders.empty(), "Unbalanced popCommandRecorder()");
+    _commandRecorders.pop_back();
+}
+
+void Renderer::replayCommands(const std::vector<RecordedCommand>& commands)
+{
+    // the current render queue might not be the one of the recording, the group commands are re-created each frame
+    const int currentRenderQueue = _commandGroupStack.top();
+    for (const auto& recorded : commands)
+    {
+        addCommand(recorded.command, recorded.renderQueue < 0 ? currentRenderQueue : recorded.renderQueue);
+    }
 }
 
 void Renderer::pushGroup(int renderQueueID)
@@ -390,11 +778,19 @@ void Renderer::processRenderCommand(RenderCommand* command)
         auto cmd = static_cast<TrianglesCommand*>(command);
         
         // flush own queue when buffer is full
-        if(_filledVertex + cmd->getVertexCount() > VBO_SIZE || _filledIndex + cmd->getIndexCount() > INDEX_VBO_SIZE)
+        if(_filledVertex + cmd->getVertexCount() > _vboSize || _filledIndex + cmd->getIndexCount() > _indexVBOSize)
         {
-            CCASSERT(cmd->getVertexCount()>= 0 && cmd->getVertexCount() < VBO_SIZE, "VBO for vertex is not big enough, please break the data down or use customized render command");
-            CCASSERT(cmd->getIndexCount()>= 0 && cmd->getIndexCount() < INDEX_VBO_SIZE, "VBO for index is not big enough, please break the data down or use customized render command");
             drawBatchedTriangles();
+
+            // grow the buffers when the command doesn't fit on its own
+            if (cmd->getVertexCount() > _vboSize || cmd->getIndexCount() > _indexVBOSize)
+            {
+                if (!growBatchBuffers((int)cmd->getVertexCount(), (int)cmd->getIndexCount()))
+                {
+                    CCASSERT(false, "VBO for vertex is not big enough and 32 bits indices are not supported, please break the data down or use customized render command");
+                    return;
+                }
+            }
         }
         
         // queue it
@@ -705,26 +1101,213 @@ void Renderer::setDepthTest(bool enable)
     CHECK_GL_ERROR_DEBUG();
 }
 
-void Renderer::fillVerticesAndIndices(const TrianglesCommand* cmd)
+template <typename IndexType>
+static void fillIndices(const TrianglesCommand* cmd, IndexType* indices, int vertexOffset)
 {
-    memcpy(&_verts[_filledVertex], cmd->getVertices(), sizeof(V3F_C4B_T2F) * cmd->getVertexCount());
+    const unsigned short* cmdIndices = cmd->getIndices();
+    for(ssize_t i=0; i< cmd->getIndexCount(); ++i)
+    {
+        indices[i] = vertexOffset + cmdIndices[i];
+    }
+}
+
+void Renderer::fillVerticesAndIndices(const TrianglesCommand* cmd, V3F_C4B_T2F* verts, void* indices, int vertexOffset, int indexOffset)
+{
+    memcpy(&verts[vertexOffset], cmd->getVertices(), sizeof(V3F_C4B_T2F) * cmd->getVertexCount());
 
     // fill vertex, and convert them to world coordinates
     const Mat4& modelView = cmd->getModelView();
-    for(ssize_t i=0; i < cmd->getVertexCount(); ++i)
+    MathUtil::transformVertices(modelView.m, &verts[vertexOffset], cmd->getVertexCount(), sizeof(V3F_C4B_T2F));
+
+    // fill index
+    if (_indexType == GL_UNSIGNED_INT)
+        fillIndices(cmd, (GLuint*)indices + indexOffset, vertexOffset);
+    else
+        fillIndices(cmd, (GLushort*)indices + indexOffset, vertexOffset);
+}
+
+void Renderer::fillQueuedTriangles(V3F_C4B_T2F* verts, void* indices, int vertexCount)
+{
+    // Each command has its own range in the buffers, so they can be filled in any order
+    auto fill = [this, verts, indices](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const auto& offset = _queuedTriangleOffsets[i];
+            fillVerticesAndIndices(_queuedTriangleCommands[i], verts, indices, offset.vertex, offset.index);
+        }
+    };
+
+    const size_t commandCount = _queuedTriangleCommands.size();
+    if (_isParallelFill && vertexCount >= PARALLEL_FILL_MIN_VERTICES && commandCount > 1)
     {
-        modelView.transformPoint(&(_verts[i + _filledVertex].vertices));
+        // a sprite is only 4 vertices: keep the chunks big enough to be worth a thread
+        const size_t averageVertices = std::max((size_t)vertexCount / commandCount, (size_t)1);
+        const size_t grainSize = std::max((size_t)PARALLEL_FILL_MIN_VERTICES / 4 / averageVertices, (size_t)1);
+        JobSystem::getInstance()->parallelFor(commandCount, grainSize, fill);
     }
+    else
+    {
+        fill(0, commandCount);
+    }
+}
 
-    // fill index
-    const unsigned short* indices = cmd->getIndices();
-    for(ssize_t i=0; i< cmd->getIndexCount(); ++i)
+// Number of batches drawBatchedTriangles() makes of the commands, in this order
+static int countTriangleBatches(const std::vector<TrianglesCommand*>& commands)
+{
+    int batches = 0;
+    int64_t prevMaterialID = -1;
+    for (const auto& cmd : commands)
     {
-        _indices[_filledIndex + i] = _filledVertex + indices[i];
+        if (cmd->isSkipBatching())
+        {
+            ++batches;
+            prevMaterialID = -1;
+        }
+        else if (cmd->getMaterialID() != prevMaterialID)
+        {
+            ++batches;
+            prevMaterialID = cmd->getMaterialID();
+        }
     }
+    return batches;
+}
 
-    _filledVertex += cmd->getVertexCount();
-    _filledIndex += cmd->getIndexCount();
+// Screen-space bounds (normalized device coordinates) of the command vertices.
+// They are infinite when some vertices are behind the camera, so the command overlaps everything.
+static void computeScreenBounds(const TrianglesCommand* cmd, const Mat4& projection, float bounds[4])
+{
+    bounds[0] = bounds[1] = -FLT_MAX;
+    bounds[2] = bounds[3] = FLT_MAX;
+
+    const ssize_t vertexCount = cmd->getVertexCount();
+    if (vertexCount == 0)
+        return;
+
+    // local bounding box
+    const V3F_C4B_T2F* verts = cmd->getVertices();
+    Vec3 minLocal = verts[0].vertices;
+    Vec3 maxLocal = verts[0].vertices;
+    for (ssize_t i = 1; i < vertexCount; ++i)
+    {
+        const Vec3& v = verts[i].vertices;
+        minLocal.x = std::min(minLocal.x, v.x); maxLocal.x = std::max(maxLocal.x, v.x);
+        minLocal.y = std::min(minLocal.y, v.y); maxLocal.y = std::max(maxLocal.y, v.y);
+        minLocal.z = std::min(minLocal.z, v.z); maxLocal.z = std::max(maxLocal.z, v.z);
+    }
+
+    // project its corners
+    const Mat4 mvp = projection * cmd->getModelView();
+    float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+    for (int corner = 0; corner < 8; ++corner)
+    {
+        Vec4 p((corner & 1) ? maxLocal.x : minLocal.x,
+               (corner & 2) ? maxLocal.y : minLocal.y,
+               (corner & 4) ? maxLocal.z : minLocal.z,
+               1);
+        mvp.transformVector(&p);
+        if (p.w <= FLT_EPSILON)
+            return;
+
+        const float x = p.x / p.w;
+        const float y = p.y / p.w;
+        minX = std::min(minX, x); maxX = std::max(maxX, x);
+        minY = std::min(minY, y); maxY = std::max(maxY, y);
+    }
+    bounds[0] = minX;
+    bounds[1] = minY;
+    bounds[2] = maxX;
+    bounds[3] = maxY;
+}
+
+// Touching edges don't overlap: the rasterization rules never draw a pixel twice on a shared edge
+static bool screenBoundsOverlap(const float a[4], const float b[4])
+{
+    return a[0] < b[2] && b[0] < a[2] && a[1] < b[3] && b[1] < a[3];
+}
+
+void Renderer::reorderQueuedTriangles()
+{
+    const int commandCount = (int)_queuedTriangleCommands.size();
+    const int batchesBefore = countTriangleBatches(_queuedTriangleCommands);
+    if (batchesBefore < 2)
+        return;
+
+    const Mat4& projection = Director::getInstance()->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+
+    _reorderCommands = _queuedTriangleCommands;
+    _reorderNext.assign(commandCount, -1);
+    _reorderBatches.clear();
+
+    // A command is appended to the last batch with its material, as long as it doesn't overlap
+    // any batch drawn after that one: it is then drawn earlier, but only before commands it doesn't touch.
+    // Commands with a different global order are never reordered, the batches before them are closed.
+    int runStart = 0;
+    float runGlobalOrder = _reorderCommands[0]->getGlobalOrder();
+    for (int i = 0; i < commandCount; ++i)
+    {
+        const auto cmd = _reorderCommands[i];
+        if (cmd->getGlobalOrder() != runGlobalOrder)
+        {
+            runGlobalOrder = cmd->getGlobalOrder();
+            runStart = (int)_reorderBatches.size();
+        }
+
+        float bounds[4];
+        computeScreenBounds(cmd, projection, bounds);
+
+        const bool batchable = !cmd->isSkipBatching();
+        int target = -1;
+        if (batchable)
+        {
+            const int lookbackEnd = std::max(runStart, (int)_reorderBatches.size() - REORDER_BATCH_LOOKBACK);
+            for (int b = (int)_reorderBatches.size() - 1; b >= lookbackEnd; --b)
+            {
+                const auto& batch = _reorderBatches[b];
+                if (batch.batchable && batch.materialID == cmd->getMaterialID())
+                {
+                    target = b;
+                    break;
+                }
+                if (screenBoundsOverlap(batch.bounds, bounds))
+                    break;
+            }
+        }
+
+        if (target >= 0)
+        {
+            auto& batch = _reorderBatches[target];
+            _reorderNext[batch.last] = i;
+            batch.last = i;
+            batch.bounds[0] = std::min(batch.bounds[0], bounds[0]);
+            batch.bounds[1] = std::min(batch.bounds[1], bounds[1]);
+            batch.bounds[2] = std::max(batch.bounds[2], bounds[2]);
+            batch.bounds[3] = std::max(batch.bounds[3], bounds[3]);
+        }
+        else
+        {
+            ReorderBatch batch;
+            batch.materialID = cmd->getMaterialID();
+            batch.batchable = batchable;
+            memcpy(batch.bounds, bounds, sizeof(bounds));
+            batch.first = batch.last = i;
+            _reorderBatches.push_back(batch);
+        }
+    }
+
+    if ((int)_reorderBatches.size() >= batchesBefore)
+        return;
+
+    int commandIndex = 0;
+    for (const auto& batch : _reorderBatches)
+    {
+        for (int i = batch.first; i >= 0; i = _reorderNext[i])
+        {
+            _queuedTriangleCommands[commandIndex++] = _reorderCommands[i];
+        }
+    }
+    CC_ASSERT(commandIndex == commandCount);
+
+    _reorderSavedBatches += batchesBefore - countTriangleBatches(_queuedTriangleCommands);
 }
 
 void Renderer::drawBatchedTriangles()
@@ -734,15 +1317,33 @@ void Renderer::drawBatchedTriangles()
 
     CCGL_DEBUG_INSERT_EVENT_MARKER("RENDERER_BATCH_TRIANGLES");
 
+    if (_isReorderForBatching && _queuedTriangleCommands.size() > 2)
+    {
+        reorderQueuedTriangles();
+    }
+
+    // processRenderCommand() already accumulated the totals of the queued commands
+    const int vertexCount = _filledVertex;
+    const int indexCount = _filledIndex;
     _filledVertex = 0;
     _filledIndex = 0;
 
+    // When streaming, vertices are written in place into the mapped buffer, skipping the copy to _verts.
+    // In that case the fill starts at the free region of the buffer instead of 0.
+    V3F_C4B_T2F* verts = _verts;
+    void* indices = _indices;
+    const bool streaming = _isStreaming && vertexCount > 0 && indexCount > 0
+        && mapStreamingBuffer(vertexCount, indexCount, &verts, &indices);
+
     /************** 1: Setup up vertices/indices *************/
 
-    _triBatchesToDraw[0].offset = 0;
+    _triBatchesToDraw[0].offset = _filledIndex;
     _triBatchesToDraw[0].indicesToDraw = 0;
     _triBatchesToDraw[0].cmd = nullptr;
 
+    _queuedTriangleOffsets.resize(_queuedTriangleCommands.size());
+    size_t commandIndex = 0;
+
     int batchesTotal = 0;
     int prevMaterialID = -1;
     bool firstCommand = true;
@@ -752,7 +1353,12 @@ void Renderer::drawBatchedTriangles()
         auto currentMaterialID = cmd->getMaterialID();
         const bool batchable = !cmd->isSkipBatching();
 
-        fillVerticesAndIndices(cmd);
+        // only compute where the command goes, it is filled once all the offsets are known
+        _queuedTriangleOffsets[commandIndex].vertex = _filledVertex;
+        _queuedTriangleOffsets[commandIndex].index = _filledIndex;
+        _filledVertex += cmd->getVertexCount();
+        _filledIndex += cmd->getIndexCount();
+        ++commandIndex;
 
         // in the same batch ?
         if (batchable && (prevMaterialID == currentMaterialID || firstCommand))
@@ -788,9 +1394,16 @@ void Renderer::drawBatchedTriangles()
     }
     batchesTotal++;
 
+    fillQueuedTriangles(verts, indices, vertexCount);
+
     /************** 2: Copy vertices/indices to GL objects *************/
     auto conf = Configuration::getInstance();
-    if (conf->supportsShareableVAO() && conf->supportsMapBuffer())
+    if (streaming)
+    {
+        // Data is already in place, the streaming VAO is bound
+        unmapStreamingBuffer();
+    }
+    else if (conf->supportsShareableVAO() && conf->supportsMapBuffer())
     {
         //Bind VAO
         GL::bindVAO(_buffersVAO);
@@ -815,13 +1428,13 @@ void Renderer::drawBatchedTriangles()
         glBindBuffer(GL_ARRAY_BUFFER, 0);
         
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * _filledIndex, _indices, GL_STATIC_DRAW);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, _indexSize * _filledIndex, _indices, GL_STATIC_DRAW);
     }
     else
     {
         // Client Side Arrays
 #define kQuadSize sizeof(_verts[0])
-#define kIndexSize sizeof(_indices[0])
+#define kIndexSize _indexSize
         glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
 
         glBufferData(GL_ARRAY_BUFFER, kQuadSize * _filledVertex, _verts, GL_DYNAMIC_DRAW);
@@ -846,13 +1459,17 @@ void Renderer::drawBatchedTriangles()
     {
         CC_ASSERT(_triBatchesToDraw[i].cmd && "Invalid batch");
         _triBatchesToDraw[i].cmd->useMaterial();
-        glDrawElements(GL_TRIANGLES, (GLsizei) _triBatchesToDraw[i].indicesToDraw, GL_UNSIGNED_SHORT, (GLvoid*) (_triBatchesToDraw[i].offset*sizeof(_indices[0])) );
+        glDrawElements(GL_TRIANGLES, (GLsizei) _triBatchesToDraw[i].indicesToDraw, _indexType, (GLvoid*) ((size_t)_triBatchesToDraw[i].offset * _indexSize) );
         _drawnBatches++;
         _drawnVertices += _triBatchesToDraw[i].indicesToDraw;
     }
 
     /************** 4: Cleanup *************/
-    if (conf->supportsShareableVAO() && conf->supportsMapBuffer())
+    if (streaming)
+    {
+        GL::bindVAO(0);
+    }
+    else if (conf->supportsShareableVAO() && conf->supportsMapBuffer())
     {
         //Unbind VAO
         GL::bindVAO(0);
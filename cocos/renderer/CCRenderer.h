@@ -113,8 +113,22 @@ public:
     void restoreRenderState();
     
 protected:
+    /**A command and its sort key, as used by the radix sort.*/
+    struct SortItem
+    {
+        uint32_t key;
+        RenderCommand* command;
+    };
+
+    /**Stable sort of a sub queue by increasing global order, or by decreasing depth.*/
+    void radixSort(std::vector<RenderCommand*>& commands, bool byDepth);
+
     /**The commands in the render queue.*/
     std::vector<RenderCommand*> _commands[QUEUE_COUNT];
+
+    /**Buffers of the radix sort, kept across frames to avoid reallocations.*/
+    std::vector<SortItem> _sortItems;
+    std::vector<SortItem> _sortScratch;
     
     /**Cull state.*/
     bool _isCullEnabled;
@@ -140,14 +154,25 @@ Whenever possible prefer to use `TrianglesCommand` objects since the renderer wi
 class CC_DLL Renderer
 {
 public:
-    /**The max number of vertices in a vertex buffer object.*/
+    /**
+     * The default number of vertices in a vertex buffer object. It can be changed with the
+     * "cocos2d.x.renderer.vbo_size" configuration key, and the buffers grow when a command needs more.
+     */
     static const int VBO_SIZE = 65536;
-    /**The max number of indices in a index buffer.*/
+    /**The default number of indices in a index buffer.*/
     static const int INDEX_VBO_SIZE = VBO_SIZE * 6 / 4;
+    /**The max number of vertices 16 bits indices can address. Bigger buffers use 32 bits indices.*/
+    static const int MAX_VBO_SIZE_16BIT_INDICES = 65536;
     /**The rendercommands which can be batched will be saved into a list, this is the reserved size of this list.*/
     static const int BATCH_TRIAGCOMMAND_RESERVED_SIZE = 64;
     /**Reserved for material id, which means that the command could not be batched.*/
     static const int MATERIAL_ID_DO_NOT_BATCH = 0;
+    /**The number of vertex/index buffers in the ring used to stream batched triangles (see CC_RENDERER_USE_STREAMING_VBO).*/
+    static const int VBO_STREAM_RING_SIZE = 3;
+    /**Below this number of vertices, the batched triangles are filled on the rendering thread only.*/
+    static const int PARALLEL_FILL_MIN_VERTICES = 4096;
+    /**When reordering for batching, the max number of batches a command can be moved back over.*/
+    static const int REORDER_BATCH_LOOKBACK = 16;
     /**Constructor.*/
     Renderer();
     /**Destructor.*/
@@ -162,6 +187,23 @@ public:
     /** Adds a `RenderComamnd` into the renderer specifying a particular render queue ID */
     void addCommand(RenderCommand* command, int renderQueue);
 
+    /** A command added to the renderer, and the render queue it was added to. */
+    struct RecordedCommand
+    {
+        RenderCommand* command;
+        /** -1 when it is the render queue that was current when the recording started */
+        int renderQueue;
+    };
+
+    /** Appends the commands added from now on to `commands`, until popCommandRecorder(). Recorders can be nested. */
+    void pushCommandRecorder(std::vector<RecordedCommand>* commands);
+
+    /** Stops the last recording started by pushCommandRecorder() */
+    void popCommandRecorder();
+
+    /** Adds the recorded commands again, as if they had been added in the same order */
+    void replayCommands(const std::vector<RecordedCommand>& commands);
+
     /** Pushes a group into the render queue */
     void pushGroup(int renderQueueID);
 
@@ -190,8 +232,33 @@ public:
     ssize_t getDrawnVertices() const { return _drawnVertices; }
     /* RenderCommands (except) TrianglesCommand should update this value */
     void addDrawnVertices(ssize_t number) { _drawnVertices += number; };
+    /* returns the number of times the renderer had to wait for the GPU to release a streaming buffer in the last frame */
+    ssize_t getStreamingBufferStalls() const { return _streamingBufferStalls; }
+    /* returns whether batched triangles are written directly into a ring of mapped buffers */
+    bool isStreamingBuffersEnabled() const { return _isStreaming; }
+    /* returns the number of vertices the batched triangles buffer can hold */
+    int getVBOSize() const { return _vboSize; }
+    /* returns the type of the batched triangles indices: GL_UNSIGNED_SHORT or GL_UNSIGNED_INT */
+    GLenum getIndexType() const { return _indexType; }
+    /**
+     * Enable/Disable filling the batched triangles (copy, model-view transform and index rebasing)
+     * from the JobSystem worker threads. Enabled by default.
+     */
+    void setParallelFillEnabled(bool enabled) { _isParallelFill = enabled; }
+    /* returns whether the batched triangles are filled from the JobSystem worker threads */
+    bool isParallelFillEnabled() const { return _isParallelFill; }
+    /**
+     * Enable/Disable reordering the queued TrianglesCommands by material to draw them in fewer batches.
+     * Only commands with the same global order are reordered, and never across a command they overlap
+     * on screen, so the result looks the same. Disabled by default.
+     */
+    void setReorderForBatchingEnabled(bool enabled) { _isReorderForBatching = enabled; }
+    /* returns whether the queued TrianglesCommands are reordered by material */
+    bool isReorderForBatchingEnabled() const { return _isReorderForBatching; }
+    /* returns the number of batches the last frame would have drawn without reordering for batching */
+    ssize_t getDrawnBatchesBeforeReorder() const { return _drawnBatches + _reorderSavedBatches; }
     /* clear draw stats */
-    void clearDrawStats() { _drawnBatches = _drawnVertices = 0; }
+    void clearDrawStats() { _drawnBatches = _drawnVertices = _streamingBufferStalls = _reorderSavedBatches = 0; }
 
     /**
      * Enable/Disable depth test
@@ -210,9 +277,19 @@ protected:
 
     //Setup VBO or VAO based on OpenGL extensions
     void setupBuffer();
+    //Allocate the batched triangles buffers, and choose their index type
+    void setupBatchBuffers();
+    //Reallocate bigger batched triangles buffers, once the queued triangles have been drawn
+    bool growBatchBuffers(int vertexCount, int indexCount);
+    void allocateBatchBuffers(int vboSize, int indexVBOSize, GLenum indexType);
     void setupVBOAndVAO();
     void setupVBO();
     void mapBuffers();
+    void setupStreamingBuffers();
+    void deleteStreamingBuffers();
+    //Map the next buffer of the streaming ring, waiting for the GPU to release it if needed
+    bool mapStreamingBuffer(int vertexCount, int indexCount, V3F_C4B_T2F** verts, void** indices);
+    void unmapStreamingBuffer();
     void drawBatchedTriangles();
 
     //Draw the previews queued triangles and flush previous context
@@ -227,7 +304,11 @@ protected:
     void processRenderCommand(RenderCommand* command);
     void visitRenderQueue(RenderQueue& queue);
 
-    void fillVerticesAndIndices(const TrianglesCommand* cmd);
+    void fillVerticesAndIndices(const TrianglesCommand* cmd, V3F_C4B_T2F* verts, void* indices, int vertexOffset, int indexOffset);
+    //Fill all the queued TrianglesCommand, in parallel when there are enough vertices
+    void fillQueuedTriangles(V3F_C4B_T2F* verts, void* indices, int vertexCount);
+    //Group the queued TrianglesCommand by material where it doesn't change the result
+    void reorderQueuedTriangles();
 
 
     /* clear color set outside be used in setGLDefaultValues() */
@@ -237,15 +318,63 @@ protected:
     
     std::vector<RenderQueue> _renderGroups;
 
+    struct CommandRecorder {
+        std::vector<RecordedCommand>* commands;
+        int renderQueue; // current render queue when the recording started
+    };
+    std::vector<CommandRecorder> _commandRecorders;
+
     MeshCommand* _lastBatchedMeshCommand;
     std::vector<TrianglesCommand*> _queuedTriangleCommands;
+    // where each queued TrianglesCommand is written in the batch buffers
+    struct TriFillOffset {
+        int vertex;
+        int index;
+    };
+    std::vector<TriFillOffset> _queuedTriangleOffsets;
+
+    // A batch built by reorderQueuedTriangles(): its commands are linked by _reorderNext
+    struct ReorderBatch {
+        uint32_t materialID;
+        bool batchable;
+        float bounds[4]; // screen-space union of its commands: minX, minY, maxX, maxY
+        int first;
+        int last;
+    };
+    std::vector<ReorderBatch> _reorderBatches;
+    std::vector<int> _reorderNext;
+    std::vector<TrianglesCommand*> _reorderCommands;
 
     //for TrianglesCommand
-    V3F_C4B_T2F _verts[VBO_SIZE];
-    GLushort _indices[INDEX_VBO_SIZE];
+    V3F_C4B_T2F* _verts;
+    void* _indices; // GLushort or GLuint, see _indexType
+    int _vboSize;
+    int _indexVBOSize;
+    GLenum _indexType;
+    GLsizei _indexSize;
     GLuint _buffersVAO;
     GLuint _buffersVBO[2]; //0: vertex  1: indices
 
+#if CC_RENDERER_USE_STREAMING_VBO
+    // One slot of the streaming ring. Batches are appended to it until it is full,
+    // then it is fenced: the fence is signaled once the GPU is done with the last draw using it.
+    struct StreamingBuffer {
+        GLuint vao;
+        GLuint vbo[2]; //0: vertex  1: indices
+        GLsync fence;
+        // first free vertex / index of the slot
+        int vertexOffset;
+        int indexOffset;
+        // only valid when the buffers are persistently mapped
+        V3F_C4B_T2F* mappedVerts;
+        void* mappedIndices;
+    };
+    StreamingBuffer _streamingBuffers[VBO_STREAM_RING_SIZE];
+    int _streamingBufferIndex;
+    bool _isStreamingPersistent;
+#endif
+    bool _isStreaming;
+
     // Internal structure that has the information for the batches
     struct TriBatchToDraw {
         TrianglesCommand* cmd;  // needed for the Material
@@ -265,10 +394,16 @@ protected:
     // stats
     ssize_t _drawnBatches;
     ssize_t _drawnVertices;
+    ssize_t _streamingBufferStalls;
+    ssize_t _reorderSavedBatches;
     //the flag for checking whether renderer is rendering
     bool _isRendering;
     
     bool _isDepthTestFor2D;
+
+    bool _isParallelFill;
+
+    bool _isReorderForBatching;
     
     GroupCommandManager* _groupCommandManager;
     
@@ -31,12 +31,15 @@ THE SOFTWARE.
 #include <stack>
 #include <cctype>
 #include <list>
+#include <atomic>
+#include <chrono>
 
 #include "renderer/CCTexture2D.h"
 #include "base/ccMacros.h"
 #include "base/ccUTF8.h"
 #include "base/CCDirector.h"
 #include "base/CCScheduler.h"
+#include "base/CCConfiguration.h"
 #include "platform/CCFileUtils.h"
 #include "base/ccUtils.h"
 #include "base/CCNinePatchImageParser.h"
@@ -67,9 +70,9 @@ TextureCache * TextureCache::getInstance()
 }
 
 TextureCache::TextureCache()
-: _loadingThread(nullptr)
-, _needQuit(false)
+: _needQuit(false)
 , _asyncRefCount(0)
+, _asyncUploadBudget(0)
 {
 }
 
@@ -80,7 +83,8 @@ TextureCache::~TextureCache()
     for (auto& texture : _textures)
         texture.second->release();
 
-    CC_SAFE_DELETE(_loadingThread);
+    for (auto& thread : _loadingThreads)
+        CC_SAFE_DELETE(thread);
 }
 
 void TextureCache::destroyInstance()
@@ -109,7 +113,7 @@ public:
       const std::string& key )
       : filename(fn), callback(f),callbackKey( key ),
         pixelFormat(Texture2D::getDefaultAlphaPixelFormat()),
-        loadSuccess(false)
+        loadSuccess(false), loaded(false)
     {}
 
     std::string filename;
@@ -119,17 +123,19 @@ public:
     Image imageAlpha;
     Texture2D::PixelFormat pixelFormat;
     bool loadSuccess;
+    // set by the Load thread once image and imageAlpha are filled
+    std::atomic<bool> loaded;
 };
 
 /**
  The addImageAsync logic follow the steps:
  - find the image has been add or not, if not add an AsyncStruct to _requestQueue  (GL thread)
- - get AsyncStruct from _requestQueue, load res and fill image data to AsyncStruct.image, then add AsyncStruct to _responseQueue (Load thread)
- - on schedule callback, get AsyncStruct from _responseQueue, convert image to texture, then delete AsyncStruct (GL thread)
+ - get AsyncStruct from _requestQueue, load res and fill image data to AsyncStruct.image, then mark it as loaded (Load threads)
+ - on schedule callback, convert the images of the loaded AsyncStructs at the front of _asyncStructQueue to textures, then delete AsyncStruct (GL thread)
 
  the Critical Area include these members:
  - _requestQueue: locked by _requestMutex
- - _responseQueue: locked by _responseMutex
+ - AsyncStruct::loaded: atomic, set by the Load thread which filled the AsyncStruct
 
  the object's life time:
  - AsyncStruct: construct and destruct in GL thread
@@ -145,8 +151,14 @@ public:
  - In addImageAsyncCallback, will deduplicate the request to ensure only create one texture.
 
  Does process all response in addImageAsyncCallback consume more time?
- - Convert image to texture faster than load image from disk, so this isn't a
- problem.
+ - Convert image to texture faster than load image from disk, but several images
+ are decoded at the same time, so setAsyncUploadBudget() can limit the time spent
+ each frame.
+
+ How are the callbacks ordered?
+ - The images are decoded out of order by several Load threads, but the callbacks
+ are called in the order of the addImageAsync calls: the callback waits for the
+ first AsyncStruct of _asyncStructQueue to be loaded.
 
  Call unbindImageAsync(path) to prevent the call to the callback when the
  texture is loaded.
@@ -159,12 +171,12 @@ void TextureCache::addImageAsync(const std::string &path, const std::function<vo
 /**
  The addImageAsync logic follow the steps:
  - find the image has been add or not, if not add an AsyncStruct to _requestQueue  (GL thread)
- - get AsyncStruct from _requestQueue, load res and fill image data to AsyncStruct.image, then add AsyncStruct to _responseQueue (Load thread)
- - on schedule callback, get AsyncStruct from _responseQueue, convert image to texture, then delete AsyncStruct (GL thread)
+ - get AsyncStruct from _requestQueue, load res and fill image data to AsyncStruct.image, then mark it as loaded (Load threads)
+ - on schedule callback, convert the images of the loaded AsyncStructs at the front of _asyncStructQueue to textures, then delete AsyncStruct (GL thread)
  
  the Critical Area include these members:
  - _requestQueue: locked by _requestMutex
- - _responseQueue: locked by _responseMutex
+ - AsyncStruct::loaded: atomic, set by the Load thread which filled the AsyncStruct
  
  the object's life time:
  - AsyncStruct: construct and destruct in GL thread
@@ -180,8 +192,14 @@ void TextureCache::addImageAsync(const std::string &path, const std::function<vo
  - In addImageAsyncCallback, will deduplicate the request to ensure only create one texture.
  
  Does process all response in addImageAsyncCallback consume more time?
- - Convert image to texture faster than load image from disk, so this isn't a
- problem.
+ - Convert image to texture faster than load image from disk, but several images
+ are decoded at the same time, so setAsyncUploadBudget() can limit the time spent
+ each frame.
+
+ How are the callbacks ordered?
+ - The images are decoded out of order by several Load threads, but the callbacks
+ are called in the order of the addImageAsync calls: the callback waits for the
+ first AsyncStruct of _asyncStructQueue to be loaded.
 
  The callbackKey allows to unbind the callback in cases where the loading of
  path is requested by several sources simultaneously. Each source can then
@@ -211,11 +229,16 @@ void TextureCache::addImageAsync(const std::string &path, const std::function<vo
     }
 
     // lazy init
-    if (_loadingThread == nullptr)
+    if (_loadingThreads.empty())
     {
-        // create a new thread to load images
-        _loadingThread = new (std::nothrow) std::thread(&TextureCache::loadImage, this);
+        // create the threads to load images
+        int threadCount = Configuration::getInstance()->getValue("cocos2d.x.texture.async_loading_threads", Value(0)).asInt();
+        if (threadCount <= 0)
+            threadCount = std::min(std::max((int)std::thread::hardware_concurrency() - 1, 1), 4);
+
         _needQuit = false;
+        for (int i = 0; i < threadCount; ++i)
+            _loadingThreads.push_back(new (std::nothrow) std::thread(&TextureCache::loadImage, this));
     }
 
     if (0 == _asyncRefCount)
@@ -270,27 +293,18 @@ void TextureCache::unbindAllImageAsync()
 void TextureCache::loadImage()
 {
     AsyncStruct *asyncStruct = nullptr;
-    std::mutex signalMutex;
-    std::unique_lock<std::mutex> signal(signalMutex);
-    while (!_needQuit)
+    while (true)
     {
         // pop an AsyncStruct from request queue
-        _requestMutex.lock();
-        if (_requestQueue.empty())
-        {
-            asyncStruct = nullptr;
-        }
-        else
         {
+            std::unique_lock<std::mutex> lock(_requestMutex);
+            _sleepCondition.wait(lock, [this]{ return _needQuit || !_requestQueue.empty(); });
+            if (_needQuit)
+                break;
+
             asyncStruct = _requestQueue.front();
             _requestQueue.pop_front();
         }
-        _requestMutex.unlock();
-
-        if (nullptr == asyncStruct) {
-            _sleepCondition.wait(signal);
-            continue;
-        }
 
         // load image
         asyncStruct->loadSuccess = asyncStruct->image.initWithImageFileThreadSafe(asyncStruct->filename);
@@ -302,39 +316,25 @@ void TextureCache::loadImage()
             if (FileUtils::getInstance()->isFileExist(alphaFile))
                 asyncStruct->imageAlpha.initWithImageFileThreadSafe(alphaFile);
         }
-        // push the asyncStruct to response queue
-        _responseMutex.lock();
-        _responseQueue.push_back(asyncStruct);
-        _responseMutex.unlock();
+        // hand the asyncStruct over to the GL thread
+        asyncStruct->loaded.store(true, std::memory_order_release);
     }
 }
 
 void TextureCache::addImageAsyncCallBack(float /*dt*/)
 {
+    auto startTime = std::chrono::steady_clock::now();
     Texture2D *texture = nullptr;
     AsyncStruct *asyncStruct = nullptr;
-    while (true)
+    while (!_asyncStructQueue.empty())
     {
-        // pop an AsyncStruct from response queue
-        _responseMutex.lock();
-        if (_responseQueue.empty())
+        // the callbacks are called in the request order, wait for the first request to be loaded
+        asyncStruct = _asyncStructQueue.front();
+        if (!asyncStruct->loaded.load(std::memory_order_acquire))
         {
-            asyncStruct = nullptr;
-        }
-        else
-        {
-            asyncStruct = _responseQueue.front();
-            _responseQueue.pop_front();
-
-            // the asyncStruct's sequence order in _asyncStructQueue must equal to the order in _responseQueue
-            CC_ASSERT(asyncStruct == _asyncStructQueue.front());
-            _asyncStructQueue.pop_front();
-        }
-        _responseMutex.unlock();
-
-        if (nullptr == asyncStruct) {
             break;
         }
+        _asyncStructQueue.pop_front();
 
         // check the image has been convert to texture or not
         auto it = _textures.find(asyncStruct->filename);
@@ -387,6 +387,14 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
         // release the asyncStruct
         delete asyncStruct;
         --_asyncRefCount;
+
+        // the remaining textures are created in the next frames
+        if (_asyncUploadBudget > 0)
+        {
+            auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+            if (elapsed >= _asyncUploadBudget * 1000000)
+                break;
+        }
     }
 
     if (0 == _asyncRefCount)
@@ -659,10 +667,13 @@ std::string TextureCache::getTextureFilePath(cocos2d::Texture2D* texture) const
 
 void TextureCache::waitForQuit()
 {
-    // notify sub thread to quick
+    // notify sub threads to quit
+    _requestMutex.lock();
     _needQuit = true;
-    _sleepCondition.notify_one();
-    if (_loadingThread) _loadingThread->join();
+    _requestMutex.unlock();
+    _sleepCondition.notify_all();
+    for (auto& thread : _loadingThreads)
+        if (thread) thread->join();
 }
 
 std::string TextureCache::getCachedTextureInfo() const
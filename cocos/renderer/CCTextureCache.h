@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include <thread>
 #include <condition_variable>
 #include <queue>
+#include <vector>
 #include <string>
 #include <unordered_map>
 #include <functional>
@@ -139,6 +140,22 @@ public:
      */
     virtual void unbindAllImageAsync();
 
+    /** Sets the time spent each frame to create the textures of the images loaded by addImageAsync().
+     * The images are decoded by several loading threads, the textures are still created in the order of the
+     * addImageAsync() calls, and the remaining ones are created in the next frames once the budget is spent.
+     * The number of loading threads is read from the "cocos2d.x.texture.async_loading_threads" configuration key,
+     * 0 (the default) uses the number of cores minus one, capped to 4.
+     *
+     * @param budget The budget in seconds, at least one texture is created each frame. 0 (the default) means no limit.
+     * @since v3.17
+     */
+    void setAsyncUploadBudget(float budget) { _asyncUploadBudget = budget; }
+
+    /** Returns the time spent each frame to create the textures of the images loaded by addImageAsync().
+     * @since v3.17
+     */
+    float getAsyncUploadBudget() const { return _asyncUploadBudget; }
+
     /** Returns a Texture2D object given an Image.
     * If the image was not previously loaded, it will create a new Texture2D object and it will return it.
     * Otherwise it will return a reference of a previously loaded image.
@@ -227,14 +244,12 @@ public:
 protected:
     struct AsyncStruct;
     
-    std::thread* _loadingThread;
+    std::vector<std::thread*> _loadingThreads;
 
     std::deque<AsyncStruct*> _asyncStructQueue;
     std::deque<AsyncStruct*> _requestQueue;
-    std::deque<AsyncStruct*> _responseQueue;
 
     std::mutex _requestMutex;
-    std::mutex _responseMutex;
     
     std::condition_variable _sleepCondition;
 
@@ -242,6 +257,8 @@ protected:
 
     int _asyncRefCount;
 
+    float _asyncUploadBudget;
+
     std::unordered_map<std::string, Texture2D*> _textures;
 
     static std::string s_etc1AlphaFileSuffix;
@@ -35,6 +35,7 @@
 #include "2d/CCMenuItem.h"
 #include "base/CCDirector.h"
 #include "base/CCEventCustom.h"
+#include "base/CCConfiguration.h"
 
 #pragma comment(lib,"lua51.lib")
 
@@ -62,6 +63,27 @@ bool LuaEngine::init(void)
 {
     _stack = LuaStack::create();
     _stack->retain();
+
+    Configuration* conf = Configuration::getInstance();
+    if (conf->getValue("cocos2d.x.lua.gc_mode", Value("auto")).asString() == "managed")
+    {
+        _stack->setGarbageCollectionMode(LuaStack::GCMode::MANAGED);
+    }
+    // budget in milliseconds
+    _stack->setGarbageCollectionBudget(conf->getValue("cocos2d.x.lua.gc_budget", Value(2.0f)).asFloat() / 1000.0f);
+    return true;
+}
+
+void LuaEngine::garbageCollectStep(float budget)
+{
+    _stack->collectGarbageStep(budget);
+}
+
+bool LuaEngine::getGarbageCollectorStats(GarbageCollectorStats* stats)
+{
+    stats->frameTime = _stack->getGarbageCollectionTime();
+    stats->heapSize = _stack->getHeapSize();
+    stats->cycles = _stack->getGarbageCollectionCycles();
     return true;
 }
 
@@ -196,6 +196,20 @@ public:
      * @return default return 0 otherwise return values the same as handleNodeEvent, handleMenuClickedEvent or handleCallFuncActionEvent,etc.
      */
     virtual int sendEvent(ScriptEvent* message) override;
+
+    /**
+     * Steps the Lua garbage collector when the LuaStack is in LuaStack::GCMode::MANAGED.
+     *
+     * @param budget The idle time left in the frame, in seconds.
+     * @since v3.17
+     */
+    virtual void garbageCollectStep(float budget) override;
+
+    /**
+     * Gets the Lua garbage collector stats.
+     * @since v3.17
+     */
+    virtual bool getGarbageCollectorStats(GarbageCollectorStats* stats) override;
     
     /**
      * Pass on the events related with ScrollView,TableCell,AssertManager, Armature, Accelerometer, Keyboard, Touch, Touches ,Mouse and Custom event to lua to handle.
@@ -26,6 +26,7 @@
 #include "scripting/lua-bindings/manual/CCLuaStack.h"
 #include "scripting/lua-bindings/manual/tolua_fix.h"
 #include <string.h>
+#include <chrono>
 #include "external/xxtea/xxtea.h"
 extern "C" {
 #include "lua.h"
@@ -303,6 +304,68 @@ int LuaStack::executeGlobalFunction(const char* functionName)
     return executeFunction(0);
 }
 
+void LuaStack::setGarbageCollectionMode(GCMode mode)
+{
+    if (_gcMode == mode)
+        return;
+
+    _gcMode = mode;
+    _gcPauseHeapSize = 0;
+    _gcLastHeapSize = lua_gc(_state, LUA_GCCOUNT, 0);
+    lua_gc(_state, mode == GCMode::MANAGED ? LUA_GCSTOP : LUA_GCRESTART, 0);
+}
+
+void LuaStack::setGarbageCollectionBudget(float budget)
+{
+    _gcBudget = MAX(0.0f, budget);
+}
+
+void LuaStack::collectGarbageStep(float budget)
+{
+    if (_gcMode != GCMode::MANAGED)
+        return;
+
+    // Amount of memory, in KB, each lua_gc step accounts for
+    static const int GC_STEP_SIZE = 8;
+    static const float GC_TIME_FILTER = 0.10f;
+
+    float elapsed = 0.0f;
+    int heapSize = lua_gc(_state, LUA_GCCOUNT, 0);
+    // Wait for the heap to grow after a completed cycle
+    if (heapSize >= _gcPauseHeapSize)
+    {
+        budget = MIN(budget, _gcBudget);
+        // The first step accounts for everything allocated since the last call, so the
+        // collector keeps up with scripts which allocate faster than the idle time allows
+        int stepSize = MAX(GC_STEP_SIZE, heapSize - _gcLastHeapSize);
+        auto start = std::chrono::steady_clock::now();
+        do
+        {
+            if (lua_gc(_state, LUA_GCSTEP, stepSize))
+            {
+                ++_gcCycles;
+                _gcPauseHeapSize = lua_gc(_state, LUA_GCCOUNT, 0) * 2;
+                break;
+            }
+            stepSize = GC_STEP_SIZE;
+            elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() / 1000000.0f;
+        } while (elapsed < budget);
+
+        elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() / 1000000.0f;
+    }
+
+    // Stepping, or collectgarbage() from scripts, re-arms the automatic collector
+    lua_gc(_state, LUA_GCSTOP, 0);
+    _gcLastHeapSize = lua_gc(_state, LUA_GCCOUNT, 0);
+
+    _gcTime = elapsed * GC_TIME_FILTER + (1 - GC_TIME_FILTER) * _gcTime;
+}
+
+size_t LuaStack::getHeapSize() const
+{
+    return (size_t)lua_gc(_state, LUA_GCCOUNT, 0) * 1024 + lua_gc(_state, LUA_GCCOUNTB, 0);
+}
+
 void LuaStack::clean(void)
 {
     lua_settop(_state, 0);
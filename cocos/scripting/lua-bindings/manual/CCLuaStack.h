@@ -336,6 +336,65 @@ public:
      * @return 1 if load successfully otherwise 0.
      */
     int luaLoadChunksFromZIP(lua_State *L);
+
+    /** Garbage collection modes.
+     * @since v3.17
+     */
+    enum class GCMode
+    {
+        /** Lua's incremental collector runs while allocating, the default. */
+        AUTO,
+        /** The collector only runs from collectGarbageStep(), in the idle time after each frame. */
+        MANAGED
+    };
+
+    /**
+     * Sets how garbage is collected.
+     *
+     * @param mode GCMode::MANAGED stops Lua's own collector and steps it once per frame from the Director.
+     * @since v3.17
+     */
+    void setGarbageCollectionMode(GCMode mode);
+
+    /** @since v3.17 */
+    GCMode getGarbageCollectionMode() const { return _gcMode; }
+
+    /**
+     * Sets the longest time collectGarbageStep() may spend per frame.
+     *
+     * @param budget The time in seconds, 0.002 by default.
+     * @since v3.17
+     */
+    void setGarbageCollectionBudget(float budget);
+
+    /** @since v3.17 */
+    float getGarbageCollectionBudget() const { return _gcBudget; }
+
+    /**
+     * Runs incremental collection steps in GCMode::MANAGED, does nothing otherwise.
+     * At least one step is done even if the frame ran late, and that step is scaled by how much
+     * the heap grew since the previous call, so collection keeps pace with allocation.
+     * Once a cycle completes, nothing is collected until the heap has doubled, like Lua's own pause.
+     *
+     * @param budget The idle time left in the frame, in seconds. It is capped by getGarbageCollectionBudget().
+     * @since v3.17
+     */
+    void collectGarbageStep(float budget);
+
+    /** Gets the smoothed time spent in collectGarbageStep() per frame, in seconds.
+     * @since v3.17
+     */
+    float getGarbageCollectionTime() const { return _gcTime; }
+
+    /** Gets the number of cycles completed by collectGarbageStep().
+     * @since v3.17
+     */
+    unsigned int getGarbageCollectionCycles() const { return _gcCycles; }
+
+    /** Gets the memory used by the lua_State, in bytes.
+     * @since v3.17
+     */
+    size_t getHeapSize() const;
     
 protected:
     LuaStack(void)
@@ -346,6 +405,12 @@ protected:
     , _xxteaKeyLen(0)
     , _xxteaSign(nullptr)
     , _xxteaSignLen(0)
+    , _gcMode(GCMode::AUTO)
+    , _gcBudget(0.002f)
+    , _gcTime(0.0f)
+    , _gcCycles(0)
+    , _gcPauseHeapSize(0)
+    , _gcLastHeapSize(0)
     {
     }
     
@@ -359,6 +424,12 @@ protected:
     int   _xxteaKeyLen;
     char* _xxteaSign;
     int   _xxteaSignLen;
+    GCMode _gcMode;
+    float _gcBudget;
+    float _gcTime;
+    unsigned int _gcCycles;
+    int _gcPauseHeapSize;
+    int _gcLastHeapSize;
 };
 
 NS_CC_END
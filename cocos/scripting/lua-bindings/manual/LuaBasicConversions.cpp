@@ -81,6 +81,42 @@ bool luaval_is_usertype(lua_State* L,int lo,const char* type, int def)
     return false;
 }
 
+/*
+ * Math types (Vec2, Size, Rect, Color...) are passed as plain tables such as {x = 1, y = 2}.
+ * Tables without a metatable are read with lua_rawget, skipping the metamethod lookup of
+ * lua_gettable, and the array form {1, 2} is accepted through lua_rawgeti.
+ */
+static inline bool luaval_is_plain_table(lua_State* L, int lo)
+{
+    if (!lua_getmetatable(L, lo))
+        return true;
+
+    lua_pop(L, 1);
+    return false;
+}
+
+static inline lua_Number luaval_number_field(lua_State* L, int lo, bool raw, const char* key, int index, lua_Number def)
+{
+    if (lo < 0 && lo > LUA_REGISTRYINDEX)
+        lo = lua_gettop(L) + lo + 1;
+
+    lua_pushstring(L, key);                             /* L: ... key */
+    if (raw)
+        lua_rawget(L, lo);                              /* L: ... table[key] */
+    else
+        lua_gettable(L, lo);
+
+    if (lua_isnil(L, -1))
+    {
+        lua_pop(L, 1);
+        lua_rawgeti(L, lo, index);                      /* L: ... table[index] */
+    }
+
+    lua_Number ret = lua_isnil(L, -1) ? def : lua_tonumber(L, -1);
+    lua_pop(L, 1);
+    return ret;
+}
+
 bool luaval_to_ushort(lua_State* L, int lo, unsigned short* outValue, const char* funcName)
 {
     if (nullptr == L || nullptr == outValue)
@@ -310,15 +346,9 @@ bool luaval_to_vec2(lua_State* L,int lo,cocos2d::Vec2* outValue, const char* fun
 
     if (ok)
     {
-        lua_pushstring(L, "x");
-        lua_gettable(L, lo);
-        outValue->x = lua_isnil(L, -1) ? 0 : lua_tonumber(L, -1);
-        lua_pop(L, 1);
-
-        lua_pushstring(L, "y");
-        lua_gettable(L, lo);
-        outValue->y = lua_isnil(L, -1) ? 0 : lua_tonumber(L, -1);
-        lua_pop(L, 1);
+        bool raw = luaval_is_plain_table(L, lo);
+        outValue->x = luaval_number_field(L, lo, raw, "x", 1, 0);
+        outValue->y = luaval_number_field(L, lo, raw, "y", 2, 0);
     }
     return ok;
 }
@@ -342,20 +372,10 @@ bool luaval_to_vec3(lua_State* L,int lo,cocos2d::Vec3* outValue, const char* fun
 
     if (ok)
     {
-        lua_pushstring(L, "x");
-        lua_gettable(L, lo);
-        outValue->x = lua_isnil(L, -1) ? 0 : lua_tonumber(L, -1);
-        lua_pop(L, 1);
-
-        lua_pushstring(L, "y");
-        lua_gettable(L, lo);
-        outValue->y = lua_isnil(L, -1) ? 0 : lua_tonumber(L, -1);
-        lua_pop(L, 1);
-
-        lua_pushstring(L, "z");
-        lua_gettable(L, lo);
-        outValue->z = lua_isnil(L, -1) ? 0 : lua_tonumber(L, -1);
-        lua_pop(L, 1);
+        bool raw = luaval_is_plain_table(L, lo);
+        outValue->x = luaval_number_field(L, lo, raw, "x", 1, 0);
+        outValue->y = luaval_number_field(L, lo, raw, "y", 2, 0);
+        outValue->z = luaval_number_field(L, lo, raw, "z", 3, 0);
     }
     return ok;
 }
@@ -379,25 +399,11 @@ bool luaval_to_vec4(lua_State* L,int lo,cocos2d::Vec4* outValue, const char* fun
 
     if (ok)
     {
-        lua_pushstring(L, "x");
-        lua_gettable(L, lo);
-        outValue->x = lua_isnil(L, -1) ? 0 : lua_tonumber(L, -1);
-        lua_pop(L, 1);
-
-        lua_pushstring(L, "y");
-        lua_gettable(L, lo);
-        outValue->y = lua_isnil(L, -1) ? 0 : lua_tonumber(L, -1);
-        lua_pop(L, 1);
-
-        lua_pushstring(L, "z");
-        lua_gettable(L, lo);
-        outValue->z = lua_isnil(L, -1) ? 0 : lua_tonumber(L, -1);
-        lua_pop(L, 1);
-
-        lua_pushstring(L, "w");
-        lua_gettable(L, lo);
-        outValue->w = lua_isnil(L, -1) ? 0 : lua_tonumber(L, -1);
-        lua_pop(L, 1);
+        bool raw = luaval_is_plain_table(L, lo);
+        outValue->x = luaval_number_field(L, lo, raw, "x", 1, 0);
+        outValue->y = luaval_number_field(L, lo, raw, "y", 2, 0);
+        outValue->z = luaval_number_field(L, lo, raw, "z", 3, 0);
+        outValue->w = luaval_number_field(L, lo, raw, "w", 4, 0);
     }
     return ok;
 }
@@ -544,15 +550,9 @@ bool luaval_to_size(lua_State* L,int lo,Size* outValue, const char* funcName)
 
     if (ok)
     {
-        lua_pushstring(L, "width");  /* L: paramStack key */
-        lua_gettable(L,lo);/* L: paramStack paramStack[lo][key] */
-        outValue->width = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);/* L: paramStack*/
-
-        lua_pushstring(L, "height");
-        lua_gettable(L,lo);
-        outValue->height = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
+        bool raw = luaval_is_plain_table(L, lo);
+        outValue->width = luaval_number_field(L, lo, raw, "width", 1, 0);
+        outValue->height = luaval_number_field(L, lo, raw, "height", 2, 0);
     }
 
     return ok;
@@ -576,25 +576,11 @@ bool luaval_to_rect(lua_State* L,int lo,Rect* outValue, const char* funcName)
 
     if (ok)
     {
-        lua_pushstring(L, "x");
-        lua_gettable(L,lo);
-        outValue->origin.x = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
-
-        lua_pushstring(L, "y");
-        lua_gettable(L,lo);
-        outValue->origin.y = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
-
-        lua_pushstring(L, "width");
-        lua_gettable(L,lo);
-        outValue->size.width = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
-
-        lua_pushstring(L, "height");
-        lua_gettable(L,lo);
-        outValue->size.height = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
+        bool raw = luaval_is_plain_table(L, lo);
+        outValue->origin.x = luaval_number_field(L, lo, raw, "x", 1, 0);
+        outValue->origin.y = luaval_number_field(L, lo, raw, "y", 2, 0);
+        outValue->size.width = luaval_number_field(L, lo, raw, "width", 3, 0);
+        outValue->size.height = luaval_number_field(L, lo, raw, "height", 4, 0);
     }
 
     return ok;
@@ -618,25 +604,11 @@ bool luaval_to_color4b(lua_State* L,int lo,Color4B* outValue, const char* funcNa
 
     if(ok)
     {
-        lua_pushstring(L, "r");
-        lua_gettable(L,lo);
-        outValue->r = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
-
-        lua_pushstring(L, "g");
-        lua_gettable(L,lo);
-        outValue->g = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
-
-        lua_pushstring(L, "b");
-        lua_gettable(L,lo);
-        outValue->b = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
-
-        lua_pushstring(L, "a");
-        lua_gettable(L,lo);
-        outValue->a = lua_isnil(L,-1) ? 255 : lua_tonumber(L,-1);
-        lua_pop(L,1);
+        bool raw = luaval_is_plain_table(L, lo);
+        outValue->r = luaval_number_field(L, lo, raw, "r", 1, 0);
+        outValue->g = luaval_number_field(L, lo, raw, "g", 2, 0);
+        outValue->b = luaval_number_field(L, lo, raw, "b", 3, 0);
+        outValue->a = luaval_number_field(L, lo, raw, "a", 4, 255);
     }
 
     return ok;
@@ -660,25 +632,11 @@ bool luaval_to_color4f(lua_State* L,int lo,Color4F* outValue, const char* funcNa
 
     if (ok)
     {
-        lua_pushstring(L, "r");
-        lua_gettable(L,lo);
-        outValue->r = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
-
-        lua_pushstring(L, "g");
-        lua_gettable(L,lo);
-        outValue->g = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
-
-        lua_pushstring(L, "b");
-        lua_gettable(L,lo);
-        outValue->b = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
-
-        lua_pushstring(L, "a");
-        lua_gettable(L,lo);
-        outValue->a = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
+        bool raw = luaval_is_plain_table(L, lo);
+        outValue->r = luaval_number_field(L, lo, raw, "r", 1, 0);
+        outValue->g = luaval_number_field(L, lo, raw, "g", 2, 0);
+        outValue->b = luaval_number_field(L, lo, raw, "b", 3, 0);
+        outValue->a = luaval_number_field(L, lo, raw, "a", 4, 0);
     }
 
     return ok;
@@ -702,20 +660,10 @@ bool luaval_to_color3b(lua_State* L,int lo,Color3B* outValue, const char* funcNa
 
     if (ok)
     {
-        lua_pushstring(L, "r");
-        lua_gettable(L,lo);
-        outValue->r = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
-
-        lua_pushstring(L, "g");
-        lua_gettable(L,lo);
-        outValue->g = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
-
-        lua_pushstring(L, "b");
-        lua_gettable(L,lo);
-        outValue->b = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
+        bool raw = luaval_is_plain_table(L, lo);
+        outValue->r = luaval_number_field(L, lo, raw, "r", 1, 0);
+        outValue->g = luaval_number_field(L, lo, raw, "g", 2, 0);
+        outValue->b = luaval_number_field(L, lo, raw, "b", 3, 0);
     }
 
     return ok;
@@ -1120,10 +1068,18 @@ bool luaval_to_mat4(lua_State* L, int lo, cocos2d::Mat4* outValue , const char*
                 ok = false;
                 break;
             }
+            bool raw = luaval_is_plain_table(L, lo);
             for (size_t i = 0; i < len; i++)
             {
-                lua_pushnumber(L,i + 1);
-                lua_gettable(L,lo);
+                if (raw)
+                {
+                    lua_rawgeti(L, lo, (int)i + 1);
+                }
+                else
+                {
+                    lua_pushnumber(L,i + 1);
+                    lua_gettable(L,lo);
+                }
                 if (tolua_isnumber(L, -1, 0, &tolua_err))
                 {
                     outValue->m[i] = tolua_tonumber(L, -1, 0);
@@ -2350,7 +2306,7 @@ void vec2_to_luaval(lua_State* L,const cocos2d::Vec2& vec2)
 {
     if (NULL  == L)
         return;
-    lua_newtable(L);                                    /* L: table */
+    lua_createtable(L, 0, 2);                           /* L: table */
     lua_pushstring(L, "x");                             /* L: table key */
     lua_pushnumber(L, (lua_Number) vec2.x);               /* L: table key value*/
     lua_rawset(L, -3);                                  /* table[key] = value, L: table */
@@ -2365,7 +2321,7 @@ void vec3_to_luaval(lua_State* L,const cocos2d::Vec3& vec3)
     if (NULL  == L)
         return;
 
-    lua_newtable(L);                                    /* L: table */
+    lua_createtable(L, 0, 3);                           /* L: table */
     lua_pushstring(L, "x");                             /* L: table key */
     lua_pushnumber(L, (lua_Number) vec3.x);             /* L: table key value*/
     lua_rawset(L, -3);                                  /* table[key] = value, L: table */
@@ -2382,7 +2338,7 @@ void vec4_to_luaval(lua_State* L,const cocos2d::Vec4& vec4)
     if (NULL  == L)
         return;
 
-    lua_newtable(L);                                    /* L: table */
+    lua_createtable(L, 0, 4);                           /* L: table */
     lua_pushstring(L, "x");                             /* L: table key */
     lua_pushnumber(L, (lua_Number) vec4.x);             /* L: table key value*/
     lua_rawset(L, -3);                                  /* table[key] = value, L: table */
@@ -2480,7 +2436,7 @@ void size_to_luaval(lua_State* L,const Size& sz)
 {
     if (NULL  == L)
         return;
-    lua_newtable(L);                                    /* L: table */
+    lua_createtable(L, 0, 2);                           /* L: table */
     lua_pushstring(L, "width");                         /* L: table key */
     lua_pushnumber(L, (lua_Number) sz.width);           /* L: table key value*/
     lua_rawset(L, -3);                                  /* table[key] = value, L: table */
@@ -2493,7 +2449,7 @@ void rect_to_luaval(lua_State* L,const Rect& rt)
 {
     if (NULL  == L)
         return;
-    lua_newtable(L);                                    /* L: table */
+    lua_createtable(L, 0, 4);                           /* L: table */
     lua_pushstring(L, "x");                             /* L: table key */
     lua_pushnumber(L, (lua_Number) rt.origin.x);               /* L: table key value*/
     lua_rawset(L, -3);                                  /* table[key] = value, L: table */
@@ -2512,7 +2468,7 @@ void color4b_to_luaval(lua_State* L,const Color4B& cc)
 {
     if (NULL  == L)
         return;
-    lua_newtable(L);                                    /* L: table */
+    lua_createtable(L, 0, 4);                           /* L: table */
     lua_pushstring(L, "r");                             /* L: table key */
     lua_pushnumber(L, (lua_Number) cc.r);               /* L: table key value*/
     lua_rawset(L, -3);                                  /* table[key] = value, L: table */
@@ -2531,7 +2487,7 @@ void color4f_to_luaval(lua_State* L,const Color4F& cc)
 {
     if (NULL  == L)
         return;
-    lua_newtable(L);                                    /* L: table */
+    lua_createtable(L, 0, 4);                           /* L: table */
     lua_pushstring(L, "r");                             /* L: table key */
     lua_pushnumber(L, (lua_Number) cc.r);               /* L: table key value*/
     lua_rawset(L, -3);                                  /* table[key] = value, L: table */
@@ -2550,7 +2506,7 @@ void color3b_to_luaval(lua_State* L,const Color3B& cc)
 {
     if (NULL  == L)
         return;
-    lua_newtable(L);                                    /* L: table */
+    lua_createtable(L, 0, 3);                           /* L: table */
     lua_pushstring(L, "r");                             /* L: table key */
     lua_pushnumber(L, (lua_Number) cc.r);               /* L: table key value*/
     lua_rawset(L, -3);                                  /* table[key] = value, L: table */
@@ -3069,15 +3025,12 @@ void mat4_to_luaval(lua_State* L, const cocos2d::Mat4& mat)
     if (nullptr  == L)
         return;
 
-    lua_newtable(L);                                    /* L: table */
-    int indexTable = 1;
+    lua_createtable(L, 16, 0);                          /* L: table */
 
     for (int i = 0; i < 16; i++)
     {
-        lua_pushnumber(L, (lua_Number)indexTable);
         lua_pushnumber(L, (lua_Number)mat.m[i]);
-        lua_rawset(L, -3);
-        ++indexTable;
+        lua_rawseti(L, -2, i + 1);
     }
 }
 
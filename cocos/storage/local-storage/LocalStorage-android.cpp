@@ -130,4 +130,10 @@ void localStorageClear()
     JniHelper::callStaticVoidMethod(className, "clear");
 }
 
+/** the Java implementation writes synchronously */
+void localStorageFlush()
+{
+    assert( _initialized );
+}
+
 #endif // #if (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID)
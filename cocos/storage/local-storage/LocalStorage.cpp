@@ -36,6 +36,38 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <sqlite3.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+/*
+ Writes are not run on the calling thread. setItem, removeItem and clear update
+ the cache and append an operation to a queue; a writer thread runs everything
+ queued so far in one transaction. getItem is answered from the cache, which
+ holds pending writes, and only reads the database for keys it doesn't know yet.
+ */
+
+enum class Operation
+{
+    SET,
+    REMOVE,
+    CLEAR
+};
+
+struct PendingWrite
+{
+    Operation operation;
+    std::string key;
+    std::string value;
+};
+
+struct CacheEntry
+{
+    bool exists;
+    std::string value;
+};
 
 static int _initialized = 0;
 static sqlite3 *_db;
@@ -44,6 +76,25 @@ static sqlite3_stmt *_stmt_remove;
 static sqlite3_stmt *_stmt_update;
 static sqlite3_stmt *_stmt_clear;
 
+// guards _db and the statements, which are used by the caller and the writer thread
+static std::mutex _dbMutex;
+
+// guards the cache
+static std::mutex _cacheMutex;
+static std::unordered_map<std::string, CacheEntry> _cache;
+// set by clear: keys which are not in the cache don't exist
+static bool _cacheComplete = false;
+
+// guards the queue and the counters
+static std::mutex _queueMutex;
+static std::condition_variable _queueCondition;
+static std::condition_variable _flushCondition;
+static std::deque<PendingWrite> _queue;
+static unsigned long long _queuedCount = 0;
+static unsigned long long _writtenCount = 0;
+static bool _quit = false;
+static std::thread _writerThread;
+
 
 static void localStorageCreateTable()
 {
@@ -57,6 +108,73 @@ static void localStorageCreateTable()
         printf("Error in CREATE TABLE\n");
 }
 
+static void localStorageWrite(const PendingWrite& write)
+{
+    int ok = SQLITE_OK;
+    switch (write.operation)
+    {
+        case Operation::SET:
+            ok |= sqlite3_bind_text(_stmt_update, 1, write.key.c_str(), -1, SQLITE_STATIC);
+            ok |= sqlite3_bind_text(_stmt_update, 2, write.value.c_str(), -1, SQLITE_STATIC);
+            ok |= sqlite3_step(_stmt_update);
+            ok |= sqlite3_reset(_stmt_update);
+            break;
+        case Operation::REMOVE:
+            ok |= sqlite3_bind_text(_stmt_remove, 1, write.key.c_str(), -1, SQLITE_STATIC);
+            ok |= sqlite3_step(_stmt_remove);
+            ok |= sqlite3_reset(_stmt_remove);
+            break;
+        case Operation::CLEAR:
+            ok |= sqlite3_step(_stmt_clear);
+            ok |= sqlite3_reset(_stmt_clear);
+            break;
+    }
+
+    if (ok != SQLITE_OK && ok != SQLITE_DONE)
+        printf("Error in localStorage write: %s\n", sqlite3_errmsg(_db));
+}
+
+static void localStorageWriterLoop()
+{
+    std::deque<PendingWrite> batch;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_queueMutex);
+            _queueCondition.wait(lock, []{ return _quit || !_queue.empty(); });
+            if (_queue.empty())
+                break;
+            batch.swap(_queue);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_dbMutex);
+            sqlite3_exec(_db, "BEGIN;", nullptr, nullptr, nullptr);
+            for (const auto& write : batch)
+                localStorageWrite(write);
+            if (sqlite3_exec(_db, "COMMIT;", nullptr, nullptr, nullptr) != SQLITE_OK)
+                printf("Error committing localStorage: %s\n", sqlite3_errmsg(_db));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_queueMutex);
+            _writtenCount += batch.size();
+        }
+        _flushCondition.notify_all();
+        batch.clear();
+    }
+}
+
+static void localStorageEnqueue(Operation operation, const std::string& key, const std::string& value)
+{
+    {
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        _queue.push_back({operation, key, value});
+        ++_queuedCount;
+    }
+    _queueCondition.notify_one();
+}
+
 void localStorageInit( const std::string& fullpath/* = "" */)
 {
     if (!_initialized) {
@@ -68,6 +186,13 @@ void localStorageInit( const std::string& fullpath/* = "" */)
         else
             ret = sqlite3_open(fullpath.c_str(), &_db);
 
+        if (!fullpath.empty())
+        {
+            // commits only append to the log, the database file is synced at checkpoints
+            sqlite3_exec(_db, "PRAGMA journal_mode=WAL;", nullptr, nullptr, nullptr);
+            sqlite3_exec(_db, "PRAGMA synchronous=NORMAL;", nullptr, nullptr, nullptr);
+        }
+
         localStorageCreateTable();
 
         // SELECT
@@ -90,6 +215,18 @@ void localStorageInit( const std::string& fullpath/* = "" */)
             printf("Error initializing DB\n");
             // report error
         }
+
+        _quit = false;
+        _writerThread = std::thread(&localStorageWriterLoop);
+
+        // nothing has to call localStorageFree, the queued writes are flushed and the writer
+        // is joined at exit, before the statics above are destroyed
+        static bool exitHandlerRegistered = false;
+        if (!exitHandlerRegistered)
+        {
+            atexit(&localStorageFree);
+            exitHandlerRegistered = true;
+        }
 		
         _initialized = 1;
     }
@@ -98,11 +235,26 @@ void localStorageInit( const std::string& fullpath/* = "" */)
 void localStorageFree()
 {
     if (_initialized) {
+        {
+            std::lock_guard<std::mutex> lock(_queueMutex);
+            _quit = true;
+        }
+        // the writer thread drains the queue before it exits
+        _queueCondition.notify_one();
+        _writerThread.join();
+
         sqlite3_finalize(_stmt_select);
         sqlite3_finalize(_stmt_remove);
         sqlite3_finalize(_stmt_update);
+        sqlite3_finalize(_stmt_clear);
 
         sqlite3_close(_db);
+
+        {
+            std::lock_guard<std::mutex> lock(_cacheMutex);
+            _cache.clear();
+            _cacheComplete = false;
+        }
 		
         _initialized = 0;
     }
@@ -112,16 +264,15 @@ void localStorageFree()
 void localStorageSetItem( const std::string& key, const std::string& value)
 {
     assert( _initialized );
-	
-    int ok = sqlite3_bind_text(_stmt_update, 1, key.c_str(), -1, SQLITE_TRANSIENT);
-    ok |= sqlite3_bind_text(_stmt_update, 2, value.c_str(), -1, SQLITE_TRANSIENT);
 
-    ok |= sqlite3_step(_stmt_update);
-	
-    ok |= sqlite3_reset(_stmt_update);
-	
-    if (ok != SQLITE_OK && ok != SQLITE_DONE)
-        printf("Error in localStorage.setItem()\n");
+    {
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+        auto& entry = _cache[key];
+        entry.exists = true;
+        entry.value = value;
+    }
+
+    localStorageEnqueue(Operation::SET, key, value);
 }
 
 /** gets an item from the LS */
@@ -129,26 +280,54 @@ bool localStorageGetItem( const std::string& key, std::string *outItem )
 {
     assert( _initialized );
 
-    int ok = sqlite3_reset(_stmt_select);
-
-    ok |= sqlite3_bind_text(_stmt_select, 1, key.c_str(), -1, SQLITE_TRANSIENT);
-    ok |= sqlite3_step(_stmt_select);
-    const unsigned char *text = sqlite3_column_text(_stmt_select, 0);
-
-    if (ok != SQLITE_OK && ok != SQLITE_DONE && ok != SQLITE_ROW)
-    {
-        printf("Error in localStorage.getItem()\n");
-        return false;
-    }
-    else if (!text)
     {
-        return false;
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+        auto iter = _cache.find(key);
+        if (iter != _cache.end())
+        {
+            if (!iter->second.exists)
+                return false;
+            outItem->assign(iter->second.value);
+            return true;
+        }
+        if (_cacheComplete)
+            return false;
     }
-    else
+
+    CacheEntry entry{false, std::string()};
     {
-        outItem->assign((const char*)text);
-        return true;
+        // the key has never been written through the cache, so the database is up to date for it
+        std::lock_guard<std::mutex> lock(_dbMutex);
+
+        int ok = sqlite3_reset(_stmt_select);
+
+        ok |= sqlite3_bind_text(_stmt_select, 1, key.c_str(), -1, SQLITE_TRANSIENT);
+        ok |= sqlite3_step(_stmt_select);
+        const unsigned char *text = sqlite3_column_text(_stmt_select, 0);
+
+        if (ok != SQLITE_OK && ok != SQLITE_DONE && ok != SQLITE_ROW)
+        {
+            printf("Error in localStorage.getItem()\n");
+            return false;
+        }
+        else if (text)
+        {
+            entry.exists = true;
+            entry.value.assign((const char*)text);
+        }
+        sqlite3_reset(_stmt_select);
     }
+
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+    // a clear from another thread may not be committed yet, the value read is stale
+    if (_cacheComplete && _cache.find(key) == _cache.end())
+        return false;
+    // a set or remove from another thread may have been cached meanwhile, it wins
+    auto result = _cache.emplace(key, std::move(entry));
+    if (!result.first->second.exists)
+        return false;
+    outItem->assign(result.first->second.value);
+    return true;
 }
 
 /** removes an item from the LS */
@@ -156,25 +335,38 @@ void localStorageRemoveItem( const std::string& key )
 {
     assert( _initialized );
 
-    int ok = sqlite3_bind_text(_stmt_remove, 1, key.c_str(), -1, SQLITE_TRANSIENT);
-	
-    ok |= sqlite3_step(_stmt_remove);
-	
-    ok |= sqlite3_reset(_stmt_remove);
+    {
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+        auto& entry = _cache[key];
+        entry.exists = false;
+        entry.value.clear();
+    }
 
-    if (ok != SQLITE_OK && ok != SQLITE_DONE)
-        printf("Error in localStorage.removeItem()\n");
+    localStorageEnqueue(Operation::REMOVE, key, std::string());
 }
 
 /** removes all items from the LS */
 void localStorageClear()
 {
     assert( _initialized );
-    
-    int ok = sqlite3_step(_stmt_clear);
-    
-    if( ok != SQLITE_OK && ok != SQLITE_DONE)
-        printf("Error in localStorage.clear()\n");
+
+    {
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+        _cache.clear();
+        _cacheComplete = true;
+    }
+
+    localStorageEnqueue(Operation::CLEAR, std::string(), std::string());
+}
+
+/** waits until all pending writes are committed */
+void localStorageFlush()
+{
+    assert( _initialized );
+
+    std::unique_lock<std::mutex> lock(_queueMutex);
+    unsigned long long target = _queuedCount;
+    _flushCondition.wait(lock, [target]{ return _writtenCount >= target; });
 }
 
 #endif // #if (CC_TARGET_PLATFORM != CC_PLATFORM_ANDROID)
@@ -54,6 +54,14 @@ void CC_DLL localStorageRemoveItem( const std::string& key );
 /** Removes all items from the JS. */
 void CC_DLL localStorageClear();
 
+/**
+ * Waits until all the items set or removed so far are written to the database.
+ * Writes are committed in batches on a background thread; call this before the
+ * application may be killed, e.g. when it enters the background.
+ * @since v3.17
+ */
+void CC_DLL localStorageFlush();
+
 // end group
 /// @}
 
@@ -16,8 +16,10 @@ FileUtilsTests::FileUtilsTests()
     ADD_TEST_CASE(TestGetContents);
     ADD_TEST_CASE(TestWriteData);
     ADD_TEST_CASE(TestWriteValueMap);
+    ADD_TEST_CASE(TestWriteValueMapBinary);
     ADD_TEST_CASE(TestWriteValueVector);
     ADD_TEST_CASE(TestUnicodePath);
+    ADD_TEST_CASE(TestPackFile);
     ADD_TEST_CASE(TestIsFileExistAsync);
     ADD_TEST_CASE(TestIsDirectoryExistAsync);
     ADD_TEST_CASE(TestFileFuncsAsync);
@@ -910,6 +912,118 @@ std::string TestWriteValueMap::subtitle() const
     return "";
 }
 
+void TestWriteValueMapBinary::onEnter()
+{
+    FileUtilsDemo::onEnter();
+    auto fs = FileUtils::getInstance();
+
+    auto winSize = Director::getInstance()->getWinSize();
+
+    auto readResult = Label::createWithTTF("show readResult", "fonts/Thonburi.ttf", 18);
+    this->addChild(readResult);
+    readResult->setPosition(winSize.width / 2, winSize.height / 2);
+
+    _binaryFile = fs->getWritablePath() + "testWriteValueMapBinary.plist";
+
+    auto runTests = [&]() {
+        ValueMap source = fs->getValueMapFromFile("animations/grossini-aliases.plist");
+        if (source.empty())
+            return std::string("failed: can't read the plist");
+
+        if (!fs->writeValueMapToBinaryFile(source, _binaryFile))
+            return std::string("failed: can't write the compiled file");
+
+        // the compiled file is read back by the plist loader
+        ValueMap readValueMap = fs->getValueMapFromFile(_binaryFile);
+        ValueMap& frames = readValueMap["frames"].asValueMap();
+        if (frames.size() != source["frames"].asValueMap().size())
+            return std::string("failed: frames count");
+
+        ValueMap& frame = frames["grossini_dance_01.png"].asValueMap();
+        if (frame["textureRect"].asString() != "{{2, 2}, {51, 109}}")
+            return std::string("failed: rect string");
+        if (frame["spriteOffset"].asString() != "{0, -1}")
+            return std::string("failed: point string");
+        if (frame["textureRotated"].asBool())
+            return std::string("failed: bool");
+
+        ValueVector& aliases = frame["aliases"].asValueVector();
+        if (aliases.size() != 1 || aliases.at(0).asString() != "dance_01")
+            return std::string("failed: array");
+
+        if (readValueMap["metadata"].asValueMap()["format"].asInt() != 3)
+            return std::string("failed: int");
+
+        // and can be walked in place
+        Data binary = fs->getValueMapBinaryFromFile(_binaryFile);
+        if (binary.isNull())
+            return std::string("failed: can't read the compiled file");
+
+        auto root = ValueBinary::getRoot(binary.getBytes(), binary.getSize());
+        auto item = root.find("frames").find("grossini_dance_01.png");
+        if (!item.find("textureRect").asRect().equals(Rect(2, 2, 51, 109)))
+            return std::string("failed: compiled rect");
+        if (item.find("spriteOffset").asVec2() != Vec2(0, -1))
+            return std::string("failed: compiled point");
+        if (!item.find("spriteSourceSize").asSize().equals(Size(85, 121)))
+            return std::string("failed: compiled size");
+        if (strcmp(item.find("aliases").at(0).asString(), "dance_01") != 0)
+            return std::string("failed: compiled array");
+        if (!root.find("missing").isNull())
+            return std::string("failed: missing key");
+
+        // plist files are compiled to the writable path once, then read from there
+        std::string cacheDir = fs->getWritablePath() + "valuemap_cache/";
+        if (!fs->isDirectoryExist(cacheDir))
+            _cacheDir = cacheDir;
+        bool cacheEnabled = fs->isValueMapBinaryCacheEnabled();
+        fs->setValueMapBinaryCacheEnabled(true);
+        Data compiled = fs->getValueMapBinaryFromFile("animations/grossini-aliases.plist");
+        Data cached = fs->getValueMapBinaryFromFile("animations/grossini-aliases.plist");
+        fs->setValueMapBinaryCacheEnabled(cacheEnabled);
+        if (!ValueBinary::isValueBinary(compiled.getBytes(), compiled.getSize()))
+            return std::string("failed: compile cache");
+        if (cached.getSize() != compiled.getSize() || memcmp(cached.getBytes(), compiled.getBytes(), cached.getSize()) != 0)
+            return std::string("failed: cached file");
+
+        // sprite frames are created from the compiled file
+        auto cache = SpriteFrameCache::getInstance();
+        cache->addSpriteFramesWithFile(_binaryFile, "animations/grossini-aliases.png");
+        auto spriteFrame = cache->getSpriteFrameByName("grossini_dance_01.png");
+        bool framesMatch = spriteFrame
+            && spriteFrame->getRectInPixels().equals(Rect(2, 2, 51, 109))
+            && spriteFrame->getOriginalSizeInPixels().equals(Size(85, 121))
+            && cache->getSpriteFrameByName("dance_01") == spriteFrame;
+        cache->removeSpriteFramesFromFile(_binaryFile);
+        if (!framesMatch)
+            return std::string("failed: sprite frames");
+
+        return std::string("read success");
+    };
+    readResult->setString("ValueBinary round trip " + runTests());
+}
+
+void TestWriteValueMapBinary::onExit()
+{
+    if (!_binaryFile.empty())
+        FileUtils::getInstance()->removeFile(_binaryFile);
+    // only when the test created it
+    if (!_cacheDir.empty())
+        FileUtils::getInstance()->removeDirectory(_cacheDir);
+
+    FileUtilsDemo::onExit();
+}
+
+std::string TestWriteValueMapBinary::title() const
+{
+    return "FileUtils: TestWriteValueMapBinary";
+}
+
+std::string TestWriteValueMapBinary::subtitle() const
+{
+    return "Compiles a plist and reads it back";
+}
+
 void TestWriteValueVector::onEnter()
 {
     FileUtilsDemo::onEnter();
@@ -1112,6 +1226,94 @@ std::string TestUnicodePath::subtitle() const
     return "";
 }
 
+// TestPackFile
+
+void TestPackFile::onEnter()
+{
+    FileUtilsDemo::onEnter();
+    auto fs = FileUtils::getInstance();
+
+    auto winSize = Director::getInstance()->getWinSize();
+
+    auto readResult = Label::createWithTTF("show readResult", "fonts/Thonburi.ttf", 18);
+    this->addChild(readResult);
+    readResult->setPosition(winSize.width / 2, winSize.height / 2);
+
+    _sourceDir = fs->getWritablePath() + "__testPackSource/";
+    _packFile = fs->getWritablePath() + "__testPack.pack";
+    std::string mountPoint = fs->getWritablePath() + "__testPackMount/";
+
+    // large enough to be read through a mapping
+    Data bigData;
+    std::vector<unsigned char> bigBytes(100 * 1024);
+    for (size_t i = 0; i < bigBytes.size(); ++i)
+        bigBytes[i] = (unsigned char)(i * 7);
+    bigData.copy(bigBytes.data(), bigBytes.size());
+
+    auto runTests = [&]() {
+        if (!fs->createDirectory(_sourceDir + "sub")
+            || !fs->writeStringToFile("first file", _sourceDir + "first.txt")
+            || !fs->writeStringToFile("second file", _sourceDir + "sub/second.txt")
+            || !fs->writeDataToFile(bigData, _sourceDir + "sub/big.bin"))
+            return std::string("failed: can't write the source files");
+
+        if (!PackFile::createFromDirectory(_sourceDir, _packFile))
+            return std::string("failed: createFromDirectory");
+
+        // the entries are only found through the pack file from now on
+        fs->removeDirectory(_sourceDir);
+
+        if (!fs->mountPackFile(_packFile, mountPoint))
+            return std::string("failed: mountPackFile");
+
+        bool found = fs->isFileExist(mountPoint + "first.txt")
+            && fs->isFileExist(mountPoint + "sub/second.txt")
+            && !fs->isFileExist(mountPoint + "missing.txt");
+        std::string first = fs->getStringFromFile(mountPoint + "first.txt");
+        std::string second = fs->getStringFromFile(mountPoint + "sub/second.txt");
+        Data big = fs->getDataFromFile(mountPoint + "sub/big.bin");
+        Data mappedBig = fs->getMappedDataFromFile(mountPoint + "sub/big.bin");
+
+        fs->unmountPackFile(_packFile);
+        bool unmounted = !fs->isFileExist(mountPoint + "first.txt");
+
+        if (!found)
+            return std::string("failed: isFileExist");
+        if (first != "first file" || second != "second file")
+            return std::string("failed: getStringFromFile");
+        if (big.getSize() != bigData.getSize() || memcmp(big.getBytes(), bigData.getBytes(), big.getSize()) != 0)
+            return std::string("failed: getDataFromFile");
+        if (mappedBig.getSize() != bigData.getSize() || memcmp(mappedBig.getBytes(), bigData.getBytes(), mappedBig.getSize()) != 0)
+            return std::string("failed: getMappedDataFromFile");
+        if (!unmounted)
+            return std::string("failed: unmountPackFile");
+
+        return std::string("read success");
+    };
+    readResult->setString("PackFile " + runTests());
+}
+
+void TestPackFile::onExit()
+{
+    auto fs = FileUtils::getInstance();
+    if (fs->isDirectoryExist(_sourceDir))
+        fs->removeDirectory(_sourceDir);
+    if (fs->isFileExist(_packFile))
+        fs->removeFile(_packFile);
+
+    FileUtilsDemo::onExit();
+}
+
+std::string TestPackFile::title() const
+{
+    return "FileUtils: TestPackFile";
+}
+
+std::string TestPackFile::subtitle() const
+{
+    return "Packs a directory, mounts it and reads it back";
+}
+
 // TestIsFileExist
 
 void TestIsFileExistAsync::onEnter()
@@ -148,6 +148,20 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class TestWriteValueMapBinary : public FileUtilsDemo
+{
+public:
+    CREATE_FUNC(TestWriteValueMapBinary);
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+private:
+    std::string _binaryFile;
+    std::string _cacheDir;
+};
+
 class TestWriteValueVector : public FileUtilsDemo
 {
 public:
@@ -170,6 +184,20 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class TestPackFile : public FileUtilsDemo
+{
+public:
+    CREATE_FUNC(TestPackFile);
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+private:
+    std::string _sourceDir;
+    std::string _packFile;
+};
+
 class TestIsFileExistAsync : public FileUtilsDemo
 {
 public:
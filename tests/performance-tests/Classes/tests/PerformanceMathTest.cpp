@@ -40,6 +40,8 @@ PerformceMathTests::PerformceMathTests()
 {
     ADD_TEST_CASE(PerformanceMathLayer1);
     ADD_TEST_CASE(PerformanceMathLayer2);
+    ADD_TEST_CASE(PerformanceMathLayer3);
+    ADD_TEST_CASE(PerformanceMathLayer4);
 }
 
 void PerformanceMathLayer::onEnter()
@@ -164,3 +166,30 @@ void PerformanceMathLayer2::doPerformanceTest(float dt)
     CC_PROFILER_STOP(_profileName.c_str());
     
 }
+
+void PerformanceMathLayer3::doPerformanceTest(float dt)
+{
+    // the loop count is the number of vertices
+    _verts.resize(_loopCount);
+    Mat4 src;
+    Mat4::createRotation(Vec3(1,1,1), 10, &src);
+    CC_PROFILER_START(_profileName.c_str());
+    for (auto& vert : _verts)
+    {
+        src.transformPoint(&vert.vertices);
+    }
+    CC_PROFILER_STOP(_profileName.c_str());
+    
+}
+
+void PerformanceMathLayer4::doPerformanceTest(float dt)
+{
+    // the loop count is the number of vertices
+    _verts.resize(_loopCount);
+    Mat4 src;
+    Mat4::createRotation(Vec3(1,1,1), 10, &src);
+    CC_PROFILER_START(_profileName.c_str());
+    MathUtil::transformVertices(src.m, _verts.data(), _verts.size(), sizeof(V3F_C4B_T2F));
+    CC_PROFILER_STOP(_profileName.c_str());
+    
+}
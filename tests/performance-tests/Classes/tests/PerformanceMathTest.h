@@ -67,4 +67,38 @@ public:
     
 };
 
+class PerformanceMathLayer3 : public PerformanceMathLayer
+{
+public:
+    CREATE_FUNC(PerformanceMathLayer3);
+
+    PerformanceMathLayer3()
+    {
+        _profileName = "MatTransformPointVertices";
+    }
+    
+    virtual void doPerformanceTest(float dt) override;
+    
+    virtual std::string subtitle() const override{ return "Mat4 transformPoint on V3F_C4B_T2F"; }
+private:
+    std::vector<cocos2d::V3F_C4B_T2F> _verts;
+};
+
+class PerformanceMathLayer4 : public PerformanceMathLayer
+{
+public:
+    CREATE_FUNC(PerformanceMathLayer4);
+
+    PerformanceMathLayer4()
+    {
+        _profileName = "MathUtilTransformVertices";
+    }
+    
+    virtual void doPerformanceTest(float dt) override;
+    
+    virtual std::string subtitle() const override{ return "MathUtil::transformVertices on V3F_C4B_T2F"; }
+private:
+    std::vector<cocos2d::V3F_C4B_T2F> _verts;
+};
+
 #endif //__PERFORMANCE_MATH_TEST_H__
@@ -0,0 +1,183 @@
+#include "PerformancePhysicsTest.h"
+
+#if CC_USE_PHYSICS
+
+#include "Profile.h"
+
+USING_NS_CC;
+
+// Enable profiles for this file
+#undef CC_PROFILER_DISPLAY_TIMERS
+#define CC_PROFILER_DISPLAY_TIMERS() Profiler::getInstance()->displayTimers()
+#undef CC_PROFILER_PURGE_ALL
+#define CC_PROFILER_PURGE_ALL() Profiler::getInstance()->releaseAllTimers()
+
+#undef CC_PROFILER_START
+#define CC_PROFILER_START(__name__) ProfilingBeginTimingBlock(__name__)
+#undef CC_PROFILER_STOP
+#define CC_PROFILER_STOP(__name__) ProfilingEndTimingBlock(__name__)
+
+static const int K_INFO_COUNT_TAG = 1581;
+static const int K_INFO_STEPS_TAG = 1582;
+
+static int autoTestBodyCounts[] = {
+    500, 1000, 2000, 4000
+};
+
+PerformcePhysicsTests::PerformcePhysicsTests()
+{
+    ADD_TEST_CASE(PerformancePhysicsLayer1);
+    ADD_TEST_CASE(PerformancePhysicsLayer2);
+}
+
+bool PerformancePhysicsLayer::init()
+{
+    return TestCase::init() && initWithPhysics();
+}
+
+void PerformancePhysicsLayer::onEnter()
+{
+    TestCase::onEnter();
+    
+    CC_PROFILER_PURGE_ALL();
+    
+    if (isAutoTesting()) {
+        autoTestIndex = 0;
+        _bodyCount = autoTestBodyCounts[autoTestIndex];
+        Profile::getInstance()->testCaseBegin("PhysicsTest",
+                                              genStrVector("Type", "BodyCount", nullptr),
+                                              genStrVector("Avg", "Min", "Max", "StepsPerSecond", nullptr));
+    }
+    
+    // the world is stepped by the test, so only the step itself is measured
+    auto world = getPhysicsWorld();
+    world->setAutoStep(false);
+    world->setSolverThreads(_solverThreads);
+    world->setGravity(Vec2(0.0f, -500.0f));
+    
+    auto s = Director::getInstance()->getWinSize();
+    
+    auto edge = Node::create();
+    edge->setPhysicsBody(PhysicsBody::createEdgeBox(s));
+    edge->setPosition(Vec2(s.width/2, s.height/2));
+    addChild(edge);
+    
+    _bodiesNode = Node::create();
+    addChild(_bodiesNode);
+    
+    MenuItemFont::setFontSize(65);
+    auto decrease = MenuItemFont::create(" - ", CC_CALLBACK_1(PerformancePhysicsLayer::subBodyCount, this));
+    decrease->setColor(Color3B(0,200,20));
+    auto increase = MenuItemFont::create(" + ", CC_CALLBACK_1(PerformancePhysicsLayer::addBodyCount, this));
+    increase->setColor(Color3B(0,200,20));
+    
+    auto menu = Menu::create(decrease, increase, nullptr);
+    menu->alignItemsHorizontally();
+    menu->setPosition(Vec2(s.width/2, s.height/2));
+    addChild(menu, 1);
+    
+    auto countLabel = Label::createWithTTF("0", "fonts/Marker Felt.ttf", 30);
+    countLabel->setColor(Color3B(0,200,20));
+    countLabel->setPosition(Vec2(s.width/2, s.height/2 + 40));
+    addChild(countLabel, 1, K_INFO_COUNT_TAG);
+    
+    auto stepsLabel = Label::createWithTTF("", "fonts/Marker Felt.ttf", 30);
+    stepsLabel->setColor(Color3B(0,200,20));
+    stepsLabel->setPosition(Vec2(s.width/2, s.height/2 - 40));
+    addChild(stepsLabel, 1, K_INFO_STEPS_TAG);
+    
+    updateBodies();
+    
+    getScheduler()->schedule(schedule_selector(PerformancePhysicsLayer::doPerformanceTest), this, 0.0f, false);
+    getScheduler()->schedule(schedule_selector(PerformancePhysicsLayer::dumpProfilerInfo), this, 2, false);
+}
+
+void PerformancePhysicsLayer::addBodyCount(Ref *sender)
+{
+    _bodyCount += _stepCount;
+    updateBodies();
+}
+
+void PerformancePhysicsLayer::subBodyCount(Ref *sender)
+{
+    _bodyCount -= _stepCount;
+    _bodyCount = std::max(_bodyCount, 0);
+    updateBodies();
+}
+
+void PerformancePhysicsLayer::updateBodies()
+{
+    _bodiesNode->removeAllChildren();
+    
+    auto s = Director::getInstance()->getWinSize();
+    for (int i = 0; i < _bodyCount; ++i)
+    {
+        auto node = Node::create();
+        auto body = PhysicsBody::createCircle(4.0f);
+        // damping makes the substeps update every body, as well as the solver
+        body->setLinearDamping(0.1f);
+        node->setPhysicsBody(body);
+        node->setPosition(Vec2(CCRANDOM_0_1() * (s.width - 20) + 10, CCRANDOM_0_1() * (s.height - 20) + 10));
+        _bodiesNode->addChild(node);
+    }
+    
+    CC_PROFILER_PURGE_ALL();
+    
+    auto countLabel = (Label *) getChildByTag(K_INFO_COUNT_TAG);
+    char str[16] = {0};
+    sprintf(str, "%d bodies", _bodyCount);
+    countLabel->setString(str);
+}
+
+void PerformancePhysicsLayer::updateInfoLabel(long averageTime)
+{
+    auto stepsLabel = (Label *) getChildByTag(K_INFO_STEPS_TAG);
+    char str[32] = {0};
+    sprintf(str, "%ld steps/s", averageTime > 0 ? 1000000 / averageTime : 0);
+    stepsLabel->setString(str);
+}
+
+void PerformancePhysicsLayer::doPerformanceTest(float dt)
+{
+    CC_PROFILER_START(_profileName.c_str());
+    getPhysicsWorld()->step(1.0f / 60.0f);
+    CC_PROFILER_STOP(_profileName.c_str());
+}
+
+void PerformancePhysicsLayer::dumpProfilerInfo(float dt)
+{
+    CC_PROFILER_DISPLAY_TIMERS();
+    
+    auto timer = Profiler::getInstance()->_activeTimers.at(_profileName);
+    if (timer == nullptr)
+    {
+        return;
+    }
+    updateInfoLabel(timer->_averageTime2);
+    
+    if (this->isAutoTesting()) {
+        // record the test result to class Profile
+        auto numStr = genStr("%d", _bodyCount);
+        auto avgStr = genStr("%ldµ", timer->_averageTime2);
+        auto minStr = genStr("%ldµ", timer->minTime);
+        auto maxStr = genStr("%ldµ", timer->maxTime);
+        auto stepsStr = genStr("%ld", timer->_averageTime2 > 0 ? 1000000 / timer->_averageTime2 : 0);
+        Profile::getInstance()->addTestResult(genStrVector(_profileName.c_str(), numStr.c_str(), nullptr),
+                                              genStrVector(avgStr.c_str(), minStr.c_str(), maxStr.c_str(), stepsStr.c_str(), nullptr));
+
+        auto testsSize = sizeof(autoTestBodyCounts)/sizeof(int);
+        if (autoTestIndex >= (testsSize - 1)) {
+            this->setAutoTesting(false);
+            Profile::getInstance()->testCaseEnd();
+        }
+        else
+        {
+            // update the auto test index
+            autoTestIndex++;
+            _bodyCount = autoTestBodyCounts[autoTestIndex];
+            updateBodies();
+        }
+    }
+}
+
+#endif // CC_USE_PHYSICS
@@ -0,0 +1,75 @@
+#ifndef __PERFORMANCE_PHYSICS_TEST_H__
+#define __PERFORMANCE_PHYSICS_TEST_H__
+
+#include "BaseTest.h"
+
+#if CC_USE_PHYSICS
+
+DEFINE_TEST_SUITE(PerformcePhysicsTests);
+
+class PerformancePhysicsLayer : public TestCase
+{
+public:
+    PerformancePhysicsLayer()
+    : _bodyCount(500)
+    , _stepCount(500)
+    , _solverThreads(0)
+    , _profileName("")
+    {
+        
+    }
+    
+    virtual bool init() override;
+    virtual void onEnter() override;
+    
+    virtual std::string title() const override{ return "Physics Performance Test"; }
+    virtual std::string subtitle() const override{ return "PerformancePhysicsLayer subTitle"; }
+    
+    void addBodyCount(cocos2d::Ref* sender);
+    void subBodyCount(cocos2d::Ref* sender);
+protected:
+    void doPerformanceTest(float dt);
+    
+    void dumpProfilerInfo(float dt);
+    void updateBodies();
+    void updateInfoLabel(long averageTime);
+protected:
+    int autoTestIndex;
+    int _bodyCount;
+    int _stepCount;
+    int _solverThreads;
+    std::string _profileName;
+    cocos2d::Node* _bodiesNode;
+};
+
+class PerformancePhysicsLayer1 : public PerformancePhysicsLayer
+{
+public:
+    CREATE_FUNC(PerformancePhysicsLayer1);
+
+    PerformancePhysicsLayer1()
+    {
+        _solverThreads = 1;
+        _profileName = "PhysicsStepSerial";
+    }
+    
+    virtual std::string subtitle() const override{ return "PhysicsWorld::step, 1 solver thread"; }
+};
+
+class PerformancePhysicsLayer2 : public PerformancePhysicsLayer
+{
+public:
+    CREATE_FUNC(PerformancePhysicsLayer2);
+
+    PerformancePhysicsLayer2()
+    {
+        _solverThreads = 0;
+        _profileName = "PhysicsStepThreaded";
+    }
+    
+    virtual std::string subtitle() const override{ return "PhysicsWorld::step, one solver thread per core"; }
+};
+
+#endif // CC_USE_PHYSICS
+
+#endif //__PERFORMANCE_PHYSICS_TEST_H__
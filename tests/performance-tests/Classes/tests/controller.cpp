@@ -32,6 +32,9 @@ public:
         addTest("Callback Tests", []() { return new PerformceCallbackTests(); });
         addTest("Math Tests", []() { return new PerformceMathTests(); });
         addTest("Container Tests", []() { return new PerformceContainerTests(); });
+#if CC_USE_PHYSICS
+        addTest("Physics Tests", []() { return new PerformcePhysicsTests(); });
+#endif
     }
 };
 